@@ -13,6 +13,11 @@
 
 #include "Core/entt.hpp"
 #include "ECS/Registry.h"
+#include "ECS/Archetype.h"
+#include "ECS/Transform.h"
+#include "ECS/CommandBuffer.h"
+#include "ECS/Scheduler.h"
+#include "Core/Math.h"
 
 #if _MSC_VER
 #pragma comment(lib, "shlwapi")
@@ -21,6 +26,61 @@
 using AllTransformComponentTypes = Ecs::TranformComponentTypes;
 using AllComponentTypes = AllTransformComponentTypes;//TypeTraits::TlCat<AllTransformComponentTypes, Ecs::Placeholder64ComponentTypes>::Type;
 
+struct DenseLocationComponent
+{
+	ECS_COMPONENT_BODY(DenseLocationComponent);
+	ALIGNAS(16) glm::vec3 value{};
+};
+ECS_COMPONENT_STORAGE(DenseLocationComponent, eDense)
+
+using ChurnComponentTypes = TypeTraits::TypeList<Ecs::LocationComponent, DenseLocationComponent>;
+
+struct DenseVelocityComponent
+{
+	ECS_COMPONENT_BODY(DenseVelocityComponent);
+	ALIGNAS(16) glm::vec3 value{};
+};
+ECS_COMPONENT_STORAGE(DenseVelocityComponent, eDense)
+
+using GroupComponentTypes = TypeTraits::TypeList<DenseLocationComponent, DenseVelocityComponent>;
+
+using TaggedComponentTypes = TypeTraits::TlCat<AllTransformComponentTypes, Ecs::Placeholder64ComponentTypes>::type_t;
+
+struct SoaLocationComponent
+{
+	ECS_COMPONENT_BODY(SoaLocationComponent);
+	glm::vec3 value{};
+};
+ECS_COMPONENT_STORAGE(SoaLocationComponent, eSoa)
+
+struct SoaRotationComponent
+{
+	ECS_COMPONENT_BODY(SoaRotationComponent);
+	glm::vec3 value{};
+};
+ECS_COMPONENT_STORAGE(SoaRotationComponent, eSoa)
+
+struct SoaScaleComponent
+{
+	ECS_COMPONENT_BODY(SoaScaleComponent);
+	glm::vec3 value{1.f};
+};
+ECS_COMPONENT_STORAGE(SoaScaleComponent, eSoa)
+
+using SoaTransformComponentTypes = TypeTraits::TypeList<SoaLocationComponent, SoaRotationComponent, SoaScaleComponent>;
+
+using SoaHierarchyComponentTypes =
+	TypeTraits::TypeList<SoaLocationComponent, SoaRotationComponent, SoaScaleComponent, Ecs::HierarchyComponent>;
+
+struct SharedMaterialComponent
+{
+	ECS_COMPONENT_BODY(SharedMaterialComponent);
+	uint64_t value{};
+};
+ECS_COMPONENT_STORAGE(SharedMaterialComponent, eShared)
+
+using SharedComponentTypes = TypeTraits::TypeList<Ecs::LocationComponent, SharedMaterialComponent>;
+
 void* operator new[](size_t size, const char* , int , unsigned , const char* , int )
 {
 	return mi_malloc(size);
@@ -303,5 +363,788 @@ static void COADEach10000(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(COADEach10000)->Threads(1);
 
+static void EnttView10000(benchmark::State& state)
+{
+	entt::registry l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.create();
+		l_reg.emplace<Ecs::LocationComponent>(l_id, glm::vec3{static_cast<float32_t>(i)});
+		l_reg.emplace<Ecs::RotationComponent>(l_id, glm::vec3{static_cast<float32_t>(i)});
+		l_reg.emplace<Ecs::ScaleComponent>(l_id, glm::vec3{static_cast<float32_t>(i)});
+	}
+	for (auto _ : state)
+	{
+		l_reg.view<Ecs::LocationComponent, Ecs::RotationComponent, Ecs::ScaleComponent>().each(
+			[](auto, auto& l, auto& r, auto& s) { l.value.x += r.value.x * s.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(EnttView10000)->Threads(1);
+
+static void COADView10000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent, Ecs::RotationComponent, Ecs::ScaleComponent>(
+			[](auto, auto& l, auto& r, auto& s) { l.value.x += r.value.x * s.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADView10000)->Threads(1);
+
+static void EnttGroup10000(benchmark::State& state)
+{
+	entt::registry l_reg{10000ull};
+	auto		   l_group = l_reg.group<DenseLocationComponent, DenseVelocityComponent>();
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.create();
+		l_reg.emplace<DenseLocationComponent>(l_id, glm::vec3{static_cast<float32_t>(i)});
+		if (i % 2)
+		{
+			l_reg.emplace<DenseVelocityComponent>(l_id, glm::vec3{1.f});
+		}
+	}
+	for (auto _ : state)
+	{
+		l_group.each([](auto, auto& l, auto& v) { l.value.x += v.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(EnttGroup10000)->Threads(1);
+
+static void COADGroup10000(benchmark::State& state)
+{
+	Ecs::Registry<GroupComponentTypes> l_reg{10000ull};
+	l_reg.Group<DenseLocationComponent, DenseVelocityComponent>();
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, DenseLocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		if (i % 2)
+		{
+			l_reg.Add(l_id, DenseVelocityComponent{glm::vec3{1.f}});
+		}
+	}
+	for (auto _ : state)
+	{
+		l_reg.EachGroup<DenseLocationComponent, DenseVelocityComponent>(
+			[](auto, auto& l, auto& v) { l.value.x += v.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADGroup10000)->Threads(1);
+
+static void COADEachSparseAfterChurn10000(benchmark::State& state)
+{
+	Ecs::Registry<ChurnComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		l_reg.Add(l_reg.Create(), Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (size_t i = 0; i < 10000; i++)
+	{
+		if (i % 10)
+		{
+			l_reg.Remove<Ecs::LocationComponent>(i);
+		}
+	}
+	for (auto _ : state)
+	{
+		l_reg.Each<Ecs::LocationComponent>([](auto& d) { d.value.x = 3.14f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADEachSparseAfterChurn10000)->Threads(1);
+
+static void COADEachDenseAfterChurn10000(benchmark::State& state)
+{
+	Ecs::Registry<ChurnComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		l_reg.Add(l_reg.Create(), DenseLocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (size_t i = 0; i < 10000; i++)
+	{
+		if (i % 10)
+		{
+			l_reg.Remove<DenseLocationComponent>(i);
+		}
+	}
+	for (auto _ : state)
+	{
+		l_reg.Each<DenseLocationComponent>([](auto& d) { d.value.x = 3.14f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADEachDenseAfterChurn10000)->Threads(1);
+
+static void COADArchetypeCreateEntity1000ForLoopAddLocationComponent(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Ecs::ArchetypeRegistry<AllComponentTypes> l_reg{10000ull};
+		for (size_t i = 0; i < 1000; i++)
+		{
+			const auto l_id = l_reg.Create();
+			l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		}
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADArchetypeCreateEntity1000ForLoopAddLocationComponent)->Threads(1);
+
+static void COADArchetypeGetEntity10000ForLoop(benchmark::State& state)
+{
+	Ecs::ArchetypeRegistry<AllComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		l_reg.Add(l_reg.Create(), Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < 10000; i++)
+		{
+			nop();
+			(void)l_reg.Get<Ecs::LocationComponent>(i);
+		}
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADArchetypeGetEntity10000ForLoop)->Threads(1);
+
+static void COADArchetypeEach10000(benchmark::State& state)
+{
+	Ecs::ArchetypeRegistry<AllComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		l_reg.Add(l_reg.Create(), Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		l_reg.Each<Ecs::LocationComponent>([](auto& d)
+		{
+			d.value.x=3.14f;
+		});
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADArchetypeEach10000)->Threads(1);
+
+static void COADArchetypeView10000(benchmark::State& state)
+{
+	Ecs::ArchetypeRegistry<AllComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent, Ecs::RotationComponent, Ecs::ScaleComponent>(
+			[](auto, auto& l, auto& r, auto& s) { l.value.x += r.value.x * s.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADArchetypeView10000)->Threads(1);
+
+static void COADView100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent, Ecs::RotationComponent, Ecs::ScaleComponent>(
+			[](auto, auto& l, auto& r, auto& s) { l.value.x += r.value.x * s.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADView100000)->Threads(1);
+
+static void COADParallelView100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		l_reg.ParallelView<Ecs::LocationComponent, Ecs::RotationComponent, Ecs::ScaleComponent>(
+			[](auto, auto& l, auto& r, auto& s) { l.value.x += r.value.x * s.value.x; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADParallelView100000)->Threads(1);
+
+static void COADParallelEach100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		l_reg.Add(l_reg.Create(), Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		l_reg.ParallelEach<Ecs::LocationComponent>([](auto& d) { d.value.x = 3.14f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADParallelEach100000)->Threads(1);
+
+static void COADEntityCreateEntity50000ForLoopAddLocationComponent(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Ecs::Registry<AllComponentTypes> l_reg{50000ull};
+		for (size_t i = 0; i < 50000; i++)
+		{
+			const auto l_id = l_reg.Create();
+			l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		}
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADEntityCreateEntity50000ForLoopAddLocationComponent)->Threads(1);
+
+static void COADEntityCreateMany50000AddManyLocationComponent(benchmark::State& state)
+{
+	eastl::vector<Ecs::entity_id_t>		  l_ids(50000);
+	eastl::vector<Ecs::LocationComponent> l_components(50000);
+	for (size_t i = 0; i < 50000; i++)
+	{
+		l_components[i].value = glm::vec3{static_cast<float32_t>(i)};
+	}
+	for (auto _ : state)
+	{
+		Ecs::Registry<AllComponentTypes> l_reg{50000ull};
+		l_reg.CreateMany(l_ids.size(), l_ids);
+		l_reg.AddMany<Ecs::LocationComponent>(l_ids, l_components);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADEntityCreateMany50000AddManyLocationComponent)->Threads(1);
+
+static void EnttViewWithTag10000(benchmark::State& state)
+{
+	entt::registry l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.create();
+		l_reg.emplace<Ecs::LocationComponent>(l_id, glm::vec3{static_cast<float32_t>(i)});
+		if (i % 2)
+		{
+			l_reg.emplace<Ecs::PlaceholderComponent0>(l_id);
+		}
+	}
+	for (auto _ : state)
+	{
+		l_reg.view<Ecs::LocationComponent, Ecs::PlaceholderComponent0>().each([](auto, auto& l) { l.value.x += 1.f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(EnttViewWithTag10000)->Threads(1);
+
+static void COADViewWithTag10000(benchmark::State& state)
+{
+	Ecs::Registry<TaggedComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		if (i % 2)
+		{
+			l_reg.Add(l_id, Ecs::PlaceholderComponent0{});
+		}
+	}
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent, Ecs::PlaceholderComponent0>(
+			[](auto, auto& l, auto&) { l.value.x += 1.f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADViewWithTag10000)->Threads(1);
+
+static void COADEachQueryWithTag10000(benchmark::State& state)
+{
+	Ecs::Registry<TaggedComponentTypes> l_reg{10000ull};
+	for (size_t i = 0; i < 10000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		if (i % 2)
+		{
+			l_reg.Add(l_id, Ecs::PlaceholderComponent0{});
+		}
+	}
+	benchmark::DoNotOptimize(l_reg.Query<Ecs::LocationComponent, Ecs::PlaceholderComponent0>());
+	for (auto _ : state)
+	{
+		l_reg.EachQuery<Ecs::LocationComponent, Ecs::PlaceholderComponent0>(
+			[](auto, auto& l, auto&) { l.value.x += 1.f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADEachQueryWithTag10000)->Threads(1);
+
+static void COADViewExcludeTag100000(benchmark::State& state)
+{
+	Ecs::Registry<TaggedComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		if (i % 2)
+		{
+			l_reg.Add(l_id, Ecs::PlaceholderComponent0{});
+		}
+	}
+	eastl::vector<Ecs::entity_id_t> l_ids(l_reg.Size());
+	for (auto _ : state)
+	{
+		uint64_t l_count = 0;
+		l_reg.View<Ecs::LocationComponent>([&](auto id, auto&) {
+			if (!l_reg.IsEnabled<Ecs::PlaceholderComponent0>(id))
+			{
+				l_ids[l_count++] = id;
+			}
+		});
+		benchmark::DoNotOptimize(l_ids.data());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADViewExcludeTag100000)->Threads(1);
+
+static void COADFilterExcludeTag100000(benchmark::State& state)
+{
+	Ecs::Registry<TaggedComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		if (i % 2)
+		{
+			l_reg.Add(l_id, Ecs::PlaceholderComponent0{});
+		}
+	}
+	eastl::vector<Ecs::entity_id_t> l_ids(l_reg.Size());
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(
+			l_reg.Filter<TypeTraits::TypeList<Ecs::LocationComponent>, TypeTraits::TypeList<Ecs::PlaceholderComponent0>>(
+				l_ids));
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADFilterExcludeTag100000)->Threads(1);
+
+static void COADStats100000(benchmark::State& state)
+{
+	Ecs::Registry<TaggedComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		if (i % 2)
+		{
+			l_reg.Add(l_id, Ecs::PlaceholderComponent0{});
+		}
+	}
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(l_reg.Stats());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADStats100000)->Threads(1);
+
+static void ChurnLocations(Ecs::Registry<AllComponentTypes>& reg)
+{
+	eastl::vector<Ecs::entity_id_t> l_ids;
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = reg.Create();
+		reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_ids.push_back(l_id);
+	}
+	// Remove three of every four, the holes are spread over the whole array
+	for (size_t i = 0; i < 100000; i++)
+	{
+		if (i % 4)
+		{
+			reg.Remove<Ecs::LocationComponent>(l_ids[i]);
+		}
+	}
+}
+
+static void COADViewChurned100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	ChurnLocations(l_reg);
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent>([](auto, auto& l) { l.value.x += 1.f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADViewChurned100000)->Threads(1);
+
+static void COADViewCompacted100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	ChurnLocations(l_reg);
+	while (l_reg.Compact<Ecs::LocationComponent>(1024) > 0)
+	{
+	}
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent>([](auto, auto& l) { l.value.x += 1.f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADViewCompacted100000)->Threads(1);
+
+static void COADWorldMatrixView100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i) * 0.01f}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{1.f}});
+	}
+	eastl::vector<glm::mat4> l_matrices(l_reg.Capacity());
+	for (auto _ : state)
+	{
+		l_reg.View<Ecs::LocationComponent, Ecs::RotationComponent, Ecs::ScaleComponent>(
+			[&](auto id, auto& l, auto& r, auto& s) {
+				l_matrices[id] = glm::scale(glm::translate(glm::mat4{1.f}, l.value) * glm::mat4_cast(r.toQuat()), s.value);
+			});
+		benchmark::DoNotOptimize(l_matrices.data());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADWorldMatrixView100000)->Threads(1);
+
+static void COADWorldMatrixSoa100000(benchmark::State& state)
+{
+	Ecs::Registry<SoaTransformComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, SoaLocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, SoaRotationComponent{glm::vec3{static_cast<float32_t>(i) * 0.01f}});
+		l_reg.Add(l_id, SoaScaleComponent{glm::vec3{1.f}});
+	}
+	eastl::vector<glm::mat4> l_matrices(l_reg.Capacity());
+	for (auto _ : state)
+	{
+		Ecs::ComputeWorldMatrices<SoaLocationComponent, SoaRotationComponent, SoaScaleComponent>(l_reg, l_matrices);
+		benchmark::DoNotOptimize(l_matrices.data());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADWorldMatrixSoa100000)->Threads(1);
+
+static void COADHierarchyPropagate100000(benchmark::State& state)
+{
+	Ecs::Registry<SoaHierarchyComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, SoaLocationComponent{glm::vec3{1.f}});
+		l_reg.Add(l_id, SoaRotationComponent{glm::vec3{0.01f}});
+		l_reg.Add(l_id, SoaScaleComponent{glm::vec3{1.f}});
+
+		// Chains of ten entities, each one is the parent of the next
+		l_reg.SetParent(l_id, i % 10 ? l_id - 1 : Ecs::Registry<SoaHierarchyComponentTypes>::INVALID_ENTITY_ID);
+	}
+	eastl::vector<glm::mat4> l_matrices(l_reg.Capacity());
+	for (auto _ : state)
+	{
+		Ecs::ComputeWorldMatrices<SoaLocationComponent, SoaRotationComponent, SoaScaleComponent>(l_reg, l_matrices);
+		Ecs::PropagateWorldMatrices(l_reg, l_matrices);
+		benchmark::DoNotOptimize(l_matrices.data());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADHierarchyPropagate100000)->Threads(1);
+
+static void COADSortDense100000(benchmark::State& state)
+{
+	Ecs::Registry<ChurnComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		l_reg.Add(l_reg.Create(), DenseLocationComponent{glm::vec3{static_cast<float32_t>((i * 7919) % 100000)}});
+	}
+	uint32_t l_flip = 0;
+	for (auto _ : state)
+	{
+		// Ascending and descending in turns, so every iteration moves the components
+		l_reg.Sort<DenseLocationComponent>([&](const DenseLocationComponent& d)
+										   { return static_cast<uint32_t>(d.value.x) ^ l_flip; });
+		l_flip = ~l_flip;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADSortDense100000)->Threads(1);
+
+static void COADChangedOnePercent100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		l_reg.Add(l_reg.Create(), Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	Ecs::tick_t l_since = l_reg.AdvanceTick();
+	for (auto _ : state)
+	{
+		for (Ecs::entity_id_t l_id = 0; l_id < 100000; l_id += 100)
+		{
+			l_reg.MarkChanged<Ecs::LocationComponent>(l_id);
+		}
+		const Ecs::tick_t l_last = l_since;
+		l_since					 = l_reg.AdvanceTick();
+		l_reg.Changed<Ecs::LocationComponent>(l_last, [](auto, auto& l) { l.value.x += 1.f; });
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADChangedOnePercent100000)->Threads(1);
+
+static void COADCommandBufferSpawn10000(benchmark::State& state)
+{
+	Ecs::CommandBuffer<AllComponentTypes> l_buffer{};
+	for (auto _ : state)
+	{
+		Ecs::Registry<AllComponentTypes> l_reg{10000ull};
+		for (size_t i = 0; i < 10000; i++)
+		{
+			const auto l_id = l_buffer.Create();
+			l_buffer.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		}
+		l_reg.Playback(l_buffer);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADCommandBufferSpawn10000)->Threads(1);
+
+static void COADSchedulerIndependent100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	Ecs::Scheduler<AllComponentTypes> l_scheduler{};
+	l_scheduler.Add<TypeTraits::TypeList<>, TypeTraits::TypeList<Ecs::LocationComponent>>(
+		"Location", [](auto& reg) { reg.template Each<Ecs::LocationComponent>([](auto& d) { d.value.x += 1.0f; }); });
+	l_scheduler.Add<TypeTraits::TypeList<>, TypeTraits::TypeList<Ecs::RotationComponent>>(
+		"Rotation", [](auto& reg) { reg.template Each<Ecs::RotationComponent>([](auto& d) { d.value.x += 1.0f; }); });
+	l_scheduler.Add<TypeTraits::TypeList<>, TypeTraits::TypeList<Ecs::ScaleComponent>>(
+		"Scale", [](auto& reg) { reg.template Each<Ecs::ScaleComponent>([](auto& d) { d.value.x += 1.0f; }); });
+	for (auto _ : state)
+	{
+		l_scheduler.Run(l_reg);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADSchedulerIndependent100000)->Threads(1);
+
+static void COADSnapshotSaveLoad100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		Stream::Dynamic l_stream{};
+		l_reg.Save(l_stream);
+		Ecs::Registry<AllComponentTypes> l_loaded{0ull};
+		l_loaded.Load(l_stream);
+		benchmark::DoNotOptimize(l_loaded.Size());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADSnapshotSaveLoad100000)->Threads(1);
+
+static void COADFreezeAndWrite100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		// Only the location pages are copied by the write
+		auto l_frozen = l_reg.Freeze();
+		l_reg.Each<Ecs::LocationComponent>([](auto& d) { d.value.x += 1.0f; });
+		benchmark::DoNotOptimize(l_frozen.Size());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADFreezeAndWrite100000)->Threads(1);
+
+static void COADFreezeAndParallelWrite100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		l_reg.Add(l_reg.Create(), Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	for (auto _ : state)
+	{
+		// The jobs share pages, the frozen registry must keep its own after they write
+		auto l_frozen = l_reg.Freeze();
+		l_reg.ParallelEach<Ecs::LocationComponent>([](auto& d) { d.value.x += 1.0f; });
+		float32_t l_sum = 0.0f;
+		l_frozen.Each<Ecs::LocationComponent>([&](auto& d) { l_sum += d.value.x; });
+		benchmark::DoNotOptimize(l_sum);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADFreezeAndParallelWrite100000)->Threads(1);
+
+static void COADDeltaOnePercent100000(benchmark::State& state)
+{
+	Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::RotationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, Ecs::ScaleComponent{glm::vec3{static_cast<float32_t>(i)}});
+	}
+	Stream::Dynamic l_stream{};
+	l_reg.Save(l_stream);
+	Ecs::Registry<AllComponentTypes> l_receiver{0ull};
+	l_receiver.Load(l_stream);
+	for (auto _ : state)
+	{
+		auto l_baseline = l_reg.Freeze();
+		l_reg.AdvanceTick();
+		for (Ecs::entity_id_t i = 0; i < 100000; i += 100)
+		{
+			l_reg.Get<Ecs::LocationComponent>(i)->value.y += 1.0f;
+		}
+		Stream::Dynamic l_delta{};
+		l_reg.SaveDelta(l_baseline, l_delta);
+		l_receiver.LoadDelta(l_delta);
+		benchmark::DoNotOptimize(l_receiver.Size());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADDeltaOnePercent100000)->Threads(1);
+
+static void COADEachShared100000(benchmark::State& state)
+{
+	Ecs::Registry<SharedComponentTypes> l_reg{100000ull};
+	for (size_t i = 0; i < 100000; i++)
+	{
+		const auto l_id = l_reg.Create();
+		l_reg.Add(l_id, Ecs::LocationComponent{glm::vec3{static_cast<float32_t>(i)}});
+		l_reg.Add(l_id, SharedMaterialComponent{i % 16});
+	}
+	for (auto _ : state)
+	{
+		uint64_t l_batches = 0;
+		l_reg.EachShared<SharedMaterialComponent>(
+			[&](const SharedMaterialComponent&, eastl::span<const Ecs::entity_id_t> ids) {
+				l_batches += ids.size() > 0;
+			});
+		benchmark::DoNotOptimize(l_batches);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADEachShared100000)->Threads(1);
+
+static void COADCreateConcurrent100000(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Ecs::Registry<AllComponentTypes> l_reg{100000ull};
+		JobPool::Default().ParallelFor(100000, 1024, [&](const uint64_t begin, const uint64_t end) {
+			for (uint64_t i = begin; i < end; i++)
+			{
+				benchmark::DoNotOptimize(l_reg.CreateConcurrent());
+			}
+		});
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADCreateConcurrent100000)->Threads(1);
+
+static void COADSpawnByAdd5000(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Ecs::Registry<AllComponentTypes> l_reg{5001ull};
+		const auto						 l_prefab = l_reg.Create();
+		l_reg.Add(l_prefab, Ecs::LocationComponent{glm::vec3{1.f}});
+		l_reg.Add(l_prefab, Ecs::RotationComponent{});
+		l_reg.Add(l_prefab, Ecs::ScaleComponent{});
+		for (size_t i = 0; i < 5000; i++)
+		{
+			const auto l_id = l_reg.Create();
+			l_reg.Add(l_id, Ecs::LocationComponent{l_reg.Get<Ecs::LocationComponent>(l_prefab)->value});
+			l_reg.Add(l_id, Ecs::RotationComponent{l_reg.Get<Ecs::RotationComponent>(l_prefab)->value});
+			l_reg.Add(l_id, Ecs::ScaleComponent{l_reg.Get<Ecs::ScaleComponent>(l_prefab)->value});
+		}
+		benchmark::DoNotOptimize(l_reg.Size());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADSpawnByAdd5000)->Threads(1);
+
+static void COADInstantiate5000(benchmark::State& state)
+{
+	eastl::vector<Ecs::entity_id_t> l_ids(5000);
+	for (auto _ : state)
+	{
+		Ecs::Registry<AllComponentTypes> l_reg{5001ull};
+		const auto						 l_prefab = l_reg.Create();
+		l_reg.Add(l_prefab, Ecs::LocationComponent{glm::vec3{1.f}});
+		l_reg.Add(l_prefab, Ecs::RotationComponent{});
+		l_reg.Add(l_prefab, Ecs::ScaleComponent{});
+		l_reg.Instantiate(l_prefab, l_ids.size(), l_ids);
+		benchmark::DoNotOptimize(l_ids.data());
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(COADInstantiate5000)->Threads(1);
+
 BENCHMARK_MAIN();
 
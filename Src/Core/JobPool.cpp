@@ -0,0 +1,144 @@
+/** \file JobPool.cpp
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#include "Core/JobPool.h"
+
+/**
+ * @brief Set while the current thread executes job ranges, nested dispatches run inline.
+ */
+static thread_local bool g_inside_job = false;
+
+JobPool::JobPool(uint64_t worker_count, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST();
+	if (worker_count == 0)
+	{
+		const uint64_t l_hardware_threads = HardwareThreadCount();
+		worker_count					  = l_hardware_threads > 1 ? l_hardware_threads - 1 : 0;
+	}
+
+	RESULT_ENSURE_CALL(wake_.Create(Semaphore::CreateInfo{}, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL(done_.Create(Semaphore::CreateInfo{}, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL(dispatch_mutex_.Create(Mutex::CreateInfo{}, RESULT_ARG_PASS));
+
+	workers_	  = eastl::make_unique<Thread[]>(worker_count);
+	worker_count_ = worker_count;
+
+	JobPool* l_self = this;
+	for (uint64_t l_index = 0; l_index < worker_count_; ++l_index)
+	{
+		RESULT_ENSURE_CALL(workers_[l_index].Create(
+			Thread::CreateInfo{&WorkerMain, &l_self, sizeof(JobPool*), ThreadNativeCiFlags::eNone, true},
+			RESULT_ARG_PASS));
+	}
+	RESULT_OK();
+}
+
+JobPool::~JobPool()
+{
+	stop_.store(true, eastl::memory_order_release);
+	wake_.Release(static_cast<uint32_t>(worker_count_));
+	for (uint64_t l_index = 0; l_index < worker_count_; ++l_index)
+	{
+		workers_[l_index].Wait();
+		workers_[l_index].Destroy();
+	}
+}
+
+void JobPool::Dispatch(const uint64_t count, uint64_t grain, const range_function_t function, void* data,
+					   RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST();
+	if (count == 0)
+	{
+		RESULT_OK();
+		return;
+	}
+
+	grain					= eastl::max(grain, uint64_t{1});
+	const uint64_t l_ranges = (count + grain - 1) / grain;
+
+	// Nothing to share, or already inside a job of this thread
+	if (g_inside_job || worker_count_ == 0 || l_ranges == 1)
+	{
+		function(data, 0, count);
+		RESULT_OK();
+		return;
+	}
+
+	Mutex::Scope l_scope{&dispatch_mutex_, RESULT_ARG_PASS};
+	job_ = Job{function, data, count, grain};
+	next_.store(0, eastl::memory_order_relaxed);
+
+	// Only wake the workers that can get a range, the calling thread takes one too
+	const uint64_t l_wake = eastl::min(worker_count_, l_ranges - 1);
+	RESULT_ENSURE_CALL(wake_.Release(static_cast<uint32_t>(l_wake), RESULT_ARG_PASS));
+
+	g_inside_job = true;
+	RunRanges();
+	g_inside_job = false;
+
+	for (uint64_t l_index = 0; l_index < l_wake; ++l_index)
+	{
+		RESULT_ENSURE_CALL(done_.Wait(RESULT_ARG_PASS));
+	}
+	RESULT_OK();
+}
+
+uint64_t JobPool::WorkerCount() const
+{
+	return worker_count_;
+}
+
+JobPool& JobPool::Default()
+{
+	static JobPool l_pool{};
+	return l_pool;
+}
+
+uint64_t JobPool::HardwareThreadCount()
+{
+#if PLATFORM_WINDOWS
+	SYSTEM_INFO l_info;
+	GetSystemInfo(&l_info);
+	return l_info.dwNumberOfProcessors;
+#else
+#error Not supported yet.
+#endif
+}
+
+uint32_t JobPool::WorkerMain(thread_native_params_t params)
+{
+	JobPool* l_pool = *static_cast<JobPool**>(params);
+	g_inside_job	= true;
+	for (;;)
+	{
+		l_pool->wake_.Wait();
+		if (l_pool->stop_.load(eastl::memory_order_acquire))
+		{
+			break;
+		}
+		l_pool->RunRanges();
+		l_pool->done_.Release();
+	}
+	return 0;
+}
+
+void JobPool::RunRanges()
+{
+	const Job l_job = job_;
+	for (;;)
+	{
+		const uint64_t l_begin = next_.fetch_add(l_job.grain, eastl::memory_order_relaxed);
+		if (l_begin >= l_job.count)
+		{
+			break;
+		}
+		l_job.function(l_job.data, l_begin, eastl::min(l_begin + l_job.grain, l_job.count));
+	}
+}
@@ -0,0 +1,102 @@
+/** \file JobPool.h
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#ifndef CORE_JOB_POOL_H
+#define CORE_JOB_POOL_H
+
+#include "Core/Common.h"
+#include "Core/Thread.h"
+
+#include <EASTL/atomic.h>
+#include <EASTL/unique_ptr.h>
+
+/**
+ * @brief Job pool class.
+ *
+ * Fixed set of worker threads that execute data parallel ranges in fork-join manner.
+ *
+ * Behavior:
+ * 1. A range [0, count) is split in sub ranges of grain size, which are taken by workers with an atomic cursor.
+ * 2. The dispatching thread also executes sub ranges, and only returns when the whole range is done.
+ * 3. A dispatch from inside a job runs inline, so nested parallel loops cannot deadlock the pool.
+ * 4. Dispatches from different threads are serialized.
+ *
+ */
+class JobPool
+{
+	CLASS_BODY_NON_COPYABLE(JobPool)
+
+public:
+	using range_function_t = void (*)(void* data, uint64_t begin, uint64_t end);
+
+public:
+	/**
+	 * @brief Create the pool workers.
+	 *
+	 * @param worker_count Worker threads, zero uses one per hardware thread except the calling one.
+	 *
+	 */
+	EXPLICIT JobPool(uint64_t worker_count = 0, RESULT_PARAM_DEFINE);
+	~JobPool();
+
+public:
+	void Dispatch(uint64_t count, uint64_t grain, range_function_t function, void* data, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Parallel for over [0, count).
+	 *
+	 * @param count Range length.
+	 * @param grain Sub range length, the last one can be smaller.
+	 * @param function Callable as function(uint64_t begin, uint64_t end). It is called concurrently.
+	 *
+	 */
+	template<typename Function>
+	void ParallelFor(uint64_t count, uint64_t grain, Function&& function, RESULT_PARAM_DEFINE);
+
+	NODISCARD uint64_t WorkerCount() const;
+
+public:
+	static JobPool& Default();
+	static uint64_t HardwareThreadCount();
+
+private:
+	struct Job
+	{
+		range_function_t function;
+		void*			 data;
+		uint64_t		 count;
+		uint64_t		 grain;
+	};
+
+	static uint32_t WorkerMain(thread_native_params_t params);
+	void			RunRanges();
+
+private:
+	Job							job_{};
+	ALIGNAS(CACHE_LINE_SIZE) eastl::atomic<uint64_t> next_{};
+	eastl::atomic<bool>			stop_{};
+	Semaphore					wake_;
+	Semaphore					done_;
+	Mutex						dispatch_mutex_;
+	eastl::unique_ptr<Thread[]> workers_;
+	uint64_t					worker_count_{};
+};
+
+template<typename Function>
+void JobPool::ParallelFor(const uint64_t count, const uint64_t grain, Function&& function, RESULT_PARAM_IMPL)
+{
+	using function_t = eastl::remove_reference_t<Function>;
+	Dispatch(
+		count, grain,
+		[](void* data, const uint64_t begin, const uint64_t end) { (*static_cast<function_t*>(data))(begin, end); },
+		const_cast<void*>(static_cast<const void*>(eastl::addressof(function))), RESULT_ARG_PASS);
+}
+
+CLASS_VALIDATION(JobPool);
+
+#endif
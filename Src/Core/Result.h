@@ -377,6 +377,11 @@ enum EResult : uint64_t
 	MutexLockFailed,
 	MutexUnlockFailed,
 
+	SemaphoreCreateFailed,
+	SemaphoreDestroyFailed,
+	SemaphoreReleaseFailed,
+	SemaphoreWaitFailed,
+
 	/**
 	 * @brief Feature not allowed.
 	 *
@@ -400,6 +405,12 @@ enum EResult : uint64_t
 	EcsInvalidEntityId,
 	EcsInvalidComponentIndex,
 	EcsNoEntityAvailable,
+	EcsInvalidSpanSize,
+	EcsInvalidSnapshot,
+	EcsHierarchyCycle,
+	EcsComponentOwnedByGroup,
+	EcsComponentNotCopyable,
+	EcsQueryNotRegistered,
 
 	AssetFailedToAdd,
 	AssetLoadFailedInvalidFile,
@@ -518,10 +529,21 @@ static constexpr char* ResultString(const EResult Value)
 		RESULT_STRING_CASE_IMPL(MutexLockFailed);
 		RESULT_STRING_CASE_IMPL(MutexUnlockFailed);
 
+		RESULT_STRING_CASE_IMPL(SemaphoreCreateFailed);
+		RESULT_STRING_CASE_IMPL(SemaphoreDestroyFailed);
+		RESULT_STRING_CASE_IMPL(SemaphoreReleaseFailed);
+		RESULT_STRING_CASE_IMPL(SemaphoreWaitFailed);
+
 		RESULT_STRING_CASE_IMPL(EcsComponentAlreadyEnabled);
 		RESULT_STRING_CASE_IMPL(EcsComponentNotEnabled);
 		RESULT_STRING_CASE_IMPL(EcsInvalidEntityId);
 		RESULT_STRING_CASE_IMPL(EcsNoEntityAvailable);
+		RESULT_STRING_CASE_IMPL(EcsInvalidSpanSize);
+		RESULT_STRING_CASE_IMPL(EcsInvalidSnapshot);
+		RESULT_STRING_CASE_IMPL(EcsHierarchyCycle);
+		RESULT_STRING_CASE_IMPL(EcsComponentOwnedByGroup);
+		RESULT_STRING_CASE_IMPL(EcsComponentNotCopyable);
+		RESULT_STRING_CASE_IMPL(EcsQueryNotRegistered);
 
 		RESULT_STRING_CASE_IMPL(AssetFailedToAdd);
 		RESULT_STRING_CASE_IMPL(AssetLoadFailedInvalidFile);
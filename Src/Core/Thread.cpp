@@ -344,3 +344,77 @@ void Mutex::Destroy(RESULT_PARAM_IMPL)
 #error Not supported yet.
 #endif
 }
+
+Semaphore::Semaphore(RESULT_PARAM_IMPL)
+{
+	RESULT_UNUSED();
+}
+
+Semaphore::Semaphore(const CreateInfo& CreateInfo, RESULT_PARAM_IMPL)
+{
+	Create(CreateInfo, RESULT_ARG_PASS);
+}
+
+Semaphore::~Semaphore()
+{
+	Destroy();
+}
+
+void Semaphore::Create(const CreateInfo& CreateInfo, RESULT_PARAM_IMPL)
+{
+	Destroy();
+
+#if PLATFORM_WINDOWS
+	handle_.Ptr = CreateSemaphoreA(nullptr, static_cast<LONG>(CreateInfo.InitialCount),
+								   static_cast<LONG>(CreateInfo.MaxCount), nullptr);
+#else
+#error Not supported yet.
+#endif
+
+	if (!handle_.Ptr)
+	{
+		RESULT_ERROR(SemaphoreCreateFailed);
+	}
+
+	RESULT_OK();
+}
+
+void Semaphore::Release(const uint32_t Count, RESULT_PARAM_IMPL) const
+{
+	RESULT_CONDITION_ENSURE(handle_.Ptr, NullPtr);
+	if (Count == 0)
+	{
+		RESULT_OK();
+		return;
+	}
+#if PLATFORM_WINDOWS
+	RESULT_CONDITION_ENSURE(ReleaseSemaphore(handle_.Ptr, static_cast<LONG>(Count), nullptr) == TRUE,
+							SemaphoreReleaseFailed);
+#else
+#error Not supported yet.
+#endif
+	RESULT_OK();
+}
+
+void Semaphore::Wait(RESULT_PARAM_IMPL) const
+{
+	RESULT_CONDITION_ENSURE(handle_.Ptr, NullPtr);
+#if PLATFORM_WINDOWS
+	RESULT_CONDITION_ENSURE(WaitForSingleObject(handle_.Ptr, INFINITE) == WAIT_OBJECT_0, SemaphoreWaitFailed);
+#else
+#error Not supported yet.
+#endif
+	RESULT_OK();
+}
+
+void Semaphore::Destroy(RESULT_PARAM_IMPL)
+{
+	RESULT_CONDITION_ENSURE_NOLOG(handle_.Ptr, NullPtr);
+#if PLATFORM_WINDOWS
+	RESULT_CONDITION_ENSURE(CloseHandle(handle_.Ptr) == TRUE, SemaphoreDestroyFailed);
+	handle_.Ptr = nullptr;
+	RESULT_OK();
+#else
+#error Not supported yet.
+#endif
+}
@@ -12,10 +12,13 @@
 
 #include "Core/Common.h"
 
+#include <EASTL/numeric_limits.h>
+
 #if PLATFORM_WINDOWS
 using thread_native_params_t = void*;
 using thread_native_handle_t = HANDLE;
 using mutex_native_handle_t	 = HANDLE;
+using semaphore_native_handle_t = HANDLE;
 #endif
 
 using thread_function_t = uint32_t (*)(thread_native_params_t);
@@ -160,9 +163,45 @@ Mutex::ScopeFromOwner<OwnerClass>::~ScopeFromOwner()
 	RESULT_OK();
 }
 
+/**
+ * @brief Semaphore class.
+ *
+ */
+class Semaphore
+{
+	CLASS_BODY_NON_COPYABLE(Semaphore)
+
+public:
+	struct Handle
+	{
+		semaphore_native_handle_t Ptr;
+	};
+
+	struct CreateInfo
+	{
+		uint32_t InitialCount{};
+		uint32_t MaxCount{eastl::numeric_limits<int32_t>::max()};
+	};
+
+public:
+	EXPLICIT Semaphore(RESULT_PARAM_DEFINE);
+	EXPLICIT Semaphore(const CreateInfo& CreateInfo, RESULT_PARAM_DEFINE);
+	~Semaphore();
+
+public:
+	MAYBEUNUSED void Create(const CreateInfo& CreateInfo, RESULT_PARAM_DEFINE);
+	MAYBEUNUSED void Release(uint32_t Count = 1, RESULT_PARAM_DEFINE) const;
+	MAYBEUNUSED void Wait(RESULT_PARAM_DEFINE) const;
+	MAYBEUNUSED void Destroy(RESULT_PARAM_DEFINE);
+
+private:
+	Handle handle_{};
+};
+
 #define thread_lambda [](native_thread_params_t)
 
 CLASS_VALIDATION(Thread);
 CLASS_VALIDATION(Mutex);
+CLASS_VALIDATION(Semaphore);
 
 #endif
@@ -0,0 +1,660 @@
+/** @file Archetype.h
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#ifndef ECS_ARCHETYPE_H
+#define ECS_ARCHETYPE_H
+
+#include "Core/Common.h"
+#include "Core/Allocator.h"
+#include "ECS/Component.h"
+#include "ECS/PagedArray.h"
+#include "ECS/Registry.h"
+
+#include <EASTL/array.h>
+#include <EASTL/deque.h>
+#include <EASTL/vector.h>
+#include <EASTL/tuple.h>
+
+#ifndef ECS_ARCHETYPE_CHUNK_SIZE
+#define ECS_ARCHETYPE_CHUNK_SIZE 16384ull
+#endif
+
+#ifndef ECS_ARCHETYPE_CHUNK_ALIGNMENT
+#define ECS_ARCHETYPE_CHUNK_ALIGNMENT 64ull
+#endif
+
+namespace Ecs
+{
+
+namespace Detail
+{
+
+/**
+ * @brief Type erased operations of a component column.
+ *
+ */
+struct ArchetypeColumnInfo
+{
+	uint64_t size;
+	uint64_t alignment;
+	void (*relocate)(void* target, void* source);
+	void (*destroy)(void* target);
+};
+
+template<typename Component>
+void RelocateArchetypeColumn(void* target, void* source)
+{
+	new (target) Component{eastl::move(*static_cast<Component*>(source))};
+	static_cast<Component*>(source)->~Component();
+}
+
+template<typename Component>
+void DestroyArchetypeColumn(void* target)
+{
+	static_cast<Component*>(target)->~Component();
+}
+
+template<typename Tuple>
+struct ArchetypeColumnTable;
+
+template<typename... Components>
+struct ArchetypeColumnTable<eastl::tuple<Components...>>
+{
+	static constexpr ArchetypeColumnInfo VALUE[] = {{sizeof(Components), alignof(Components),
+													 &RelocateArchetypeColumn<Components>,
+													 &DestroyArchetypeColumn<Components>}...};
+
+	/**
+	 * @brief Worst case size of a row with every component, including alignment padding.
+	 */
+	static constexpr uint64_t ROW_SIZE = sizeof(entity_id_t) + ((sizeof(Components) + alignof(Components)) + ...);
+};
+
+} // namespace Detail
+
+/**
+ * @brief Archetype registry class.
+ *
+ * Alternative storage backend of @ref Registry, with the same type list and api.
+ *
+ * Features:
+ * 1. Entities with the same signature live together in an archetype.
+ * 2. Archetype memory is split in chunks of @ref ECS_ARCHETYPE_CHUNK_SIZE bytes, each chunk has an entity id
+ *	column followed by one column per component (SoA).
+ * 3. Queries match the archetype signature once and then walk the chunk columns linearly.
+ * 4. Adding or removing a component moves the entity to another archetype. Archetype transitions are cached.
+ *
+ * Data:
+ * 1. Paged stack of entity ids.
+ * 2. Paged array of entity locations (archetype and row).
+ * 3. Archetypes, stored in a deque so their address is stable.
+ *
+ * Component pointers are invalidated when the entity, or another one of the same archetype, changes archetype or is
+ * destroyed.
+ *
+ */
+template<typename TypeList>
+class ArchetypeRegistry final
+{
+public:
+	using components_t							   = TypeList;
+	using component_tuple_t						   = typename TypeTraits::TlToTuple<components_t>::type_t;
+	using signature_t							   = eastl::bitset<components_t::SIZE>;
+	static constexpr entity_id_t INVALID_ENTITY_ID = eastl::numeric_limits<uint64_t>::max();
+
+private:
+	using column_table_t = Detail::ArchetypeColumnTable<component_tuple_t>;
+
+	static_assert(column_table_t::ROW_SIZE <= ECS_ARCHETYPE_CHUNK_SIZE,
+				  "Archetype chunk is too small to store one entity with every component.");
+
+	struct Archetype
+	{
+		signature_t									 signature;
+		uint64_t									 rows_per_chunk{};
+		uint64_t									 size{};
+		eastl::array<uint64_t, components_t::SIZE>	 offsets{};
+		eastl::array<Archetype*, components_t::SIZE> edges{};
+		eastl::vector<uint8_t*>						 chunks;
+
+		NODISCARD entity_id_t* Entities(uint64_t chunk) const;
+		NODISCARD void*		   At(uint64_t column, uint64_t row) const;
+		NODISCARD uint64_t	   ChunkSize(uint64_t chunk) const;
+
+		template<typename Component>
+		NODISCARD Component* Column(uint64_t chunk) const;
+	};
+
+	struct EntityLocation
+	{
+		Archetype* archetype;
+		uint64_t   row;
+	};
+
+public:
+	EXPLICIT ArchetypeRegistry(uint64_t capacity = 10000ull, RESULT_PARAM_DEFINE);
+
+	ArchetypeRegistry(ArchetypeRegistry&& other) NOEXCEPT;
+	ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+	ArchetypeRegistry& operator=(ArchetypeRegistry&& other) NOEXCEPT;
+	ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+	~ArchetypeRegistry();
+
+public:
+	entity_id_t Create(RESULT_PARAM_DEFINE);
+
+	void Destroy(entity_id_t id, RESULT_PARAM_DEFINE);
+
+public:
+	template<typename Component>
+	NODISCARD bool IsEnabled(entity_id_t id, RESULT_PARAM_DEFINE) const;
+
+public:
+	template<typename Component>
+	void Add(entity_id_t id, Component&& component, RESULT_PARAM_DEFINE);
+
+	template<typename Component>
+	void Remove(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	template<typename Component>
+	Component* Get(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	template<typename Component, typename Function>
+	void Each(Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Multi-component view.
+	 *
+	 * Same contract of @ref Registry::View. The signature is tested once per archetype, then every chunk
+	 * of a matching archetype is iterated linearly.
+	 *
+	 * @tparam Components Required component types.
+	 * @tparam Function Callable type, kept as template so it can be inlined.
+	 *
+	 */
+	template<typename... Components, typename Function>
+	void View(Function&& function, RESULT_PARAM_DEFINE);
+
+public:
+	NODISCARD uint64_t Capacity(RESULT_PARAM_DEFINE) const;
+	NODISCARD uint64_t Size(RESULT_PARAM_DEFINE) const;
+	NODISCARD uint64_t ArchetypeCount(RESULT_PARAM_DEFINE) const;
+	NODISCARD bool	   Contains(entity_id_t id, RESULT_PARAM_DEFINE) const;
+	void			   Reserve(uint64_t capacity, RESULT_PARAM_DEFINE);
+	void			   Clear(RESULT_PARAM_DEFINE);
+
+private:
+	template<typename Component>
+	static constexpr uint64_t GetComponentId();
+
+	Archetype& FindOrCreateArchetype(const signature_t& signature);
+	Archetype& Traverse(Archetype& archetype, uint64_t component_id);
+	uint64_t   PushRow(Archetype& archetype, entity_id_t id);
+	void	   RemoveRow(Archetype& archetype, uint64_t row);
+	uint64_t   MoveEntity(entity_id_t id, Archetype& target);
+	void	   ReleaseArchetypes();
+	void	   GrowEntities();
+
+private:
+	uint64_t					   ecursor_{};
+	PagedArray<entity_id_t>		   entities_;
+	PagedArray<EntityLocation>	   locations_;
+	eastl::deque<Archetype>		   archetypes_;
+	Archetype*					   root_{};
+};
+
+template<typename TypeList>
+entity_id_t* ArchetypeRegistry<TypeList>::Archetype::Entities(const uint64_t chunk) const
+{
+	return reinterpret_cast<entity_id_t*>(chunks[chunk]);
+}
+
+template<typename TypeList>
+void* ArchetypeRegistry<TypeList>::Archetype::At(const uint64_t column, const uint64_t row) const
+{
+	return chunks[row / rows_per_chunk] + offsets[column] + (row % rows_per_chunk) * column_table_t::VALUE[column].size;
+}
+
+template<typename TypeList>
+uint64_t ArchetypeRegistry<TypeList>::Archetype::ChunkSize(const uint64_t chunk) const
+{
+	return eastl::min(rows_per_chunk, size - chunk * rows_per_chunk);
+}
+
+template<typename TypeList>
+template<typename Component>
+Component* ArchetypeRegistry<TypeList>::Archetype::Column(const uint64_t chunk) const
+{
+	return reinterpret_cast<Component*>(chunks[chunk] + offsets[GetComponentId<Component>()]);
+}
+
+template<typename TypeList>
+ArchetypeRegistry<TypeList>::ArchetypeRegistry(const uint64_t capacity, RESULT_PARAM_IMPL)
+{
+	ValidateComponentTuple<component_tuple_t>();
+
+	root_ = &FindOrCreateArchetype(signature_t{});
+	Reserve(capacity);
+}
+
+template<typename TypeList>
+ArchetypeRegistry<TypeList>::ArchetypeRegistry(ArchetypeRegistry&& other) NOEXCEPT
+	: ecursor_{other.ecursor_},
+	  entities_{eastl::move(other.entities_)},
+	  locations_{eastl::move(other.locations_)},
+	  root_{other.root_}
+{
+	// Swapping keeps the archetype addresses, so locations and edges stay valid
+	archetypes_.swap(other.archetypes_);
+	other.ecursor_ = 0;
+	other.root_	   = nullptr;
+}
+
+template<typename TypeList>
+ArchetypeRegistry<TypeList>& ArchetypeRegistry<TypeList>::operator=(ArchetypeRegistry&& other) NOEXCEPT
+{
+	ReleaseArchetypes();
+	archetypes_.swap(other.archetypes_);
+
+	ecursor_   = other.ecursor_;
+	entities_  = eastl::move(other.entities_);
+	locations_ = eastl::move(other.locations_);
+	root_	   = other.root_;
+
+	other.ecursor_ = 0;
+	other.root_	   = nullptr;
+	return *this;
+}
+
+template<typename TypeList>
+ArchetypeRegistry<TypeList>::~ArchetypeRegistry()
+{
+	ReleaseArchetypes();
+}
+
+template<typename TypeList>
+entity_id_t ArchetypeRegistry<TypeList>::Create(RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG(INVALID_ENTITY_ID);
+	if (ecursor_ == Capacity())
+	{
+		GrowEntities();
+	}
+	const auto l_id = entities_[ecursor_++];
+	locations_[l_id] = EntityLocation{root_, PushRow(*root_, l_id)};
+	RESULT_OK();
+	return l_id;
+}
+
+template<typename TypeList>
+void ArchetypeRegistry<TypeList>::Destroy(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!Contains(id) || !locations_[id].archetype)
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+
+	auto& [l_archetype, l_row] = locations_[id];
+	for (uint64_t l_column = 0; l_column < components_t::SIZE; ++l_column)
+	{
+		if (l_archetype->signature.test(l_column))
+		{
+			column_table_t::VALUE[l_column].destroy(l_archetype->At(l_column, l_row));
+		}
+	}
+	RemoveRow(*l_archetype, l_row);
+	locations_[id]		  = EntityLocation{nullptr, 0};
+	entities_[--ecursor_] = id;
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+bool ArchetypeRegistry<TypeList>::IsEnabled(const entity_id_t id, RESULT_PARAM_IMPL) const
+{
+	if (!Contains(id) || !locations_[id].archetype)
+	{
+		RESULT_ERROR(EcsInvalidEntityId, false);
+	}
+	RESULT_OK();
+	return locations_[id].archetype->signature.test(GetComponentId<Component>());
+}
+
+template<typename TypeList>
+template<typename Component>
+void ArchetypeRegistry<TypeList>::Add(const entity_id_t id, Component&& component, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!Contains(id) || !locations_[id].archetype)
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+
+	constexpr uint64_t l_id		   = GetComponentId<Component>();
+	Archetype&		   l_archetype = *locations_[id].archetype;
+	if (l_archetype.signature.test(l_id))
+	{
+		RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+	}
+
+	Archetype&	   l_target = Traverse(l_archetype, l_id);
+	const uint64_t l_row	= MoveEntity(id, l_target);
+	new (l_target.At(l_id, l_row)) Component{eastl::forward<Component>(component)};
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void ArchetypeRegistry<TypeList>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!Contains(id) || !locations_[id].archetype)
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+
+	constexpr uint64_t l_id		   = GetComponentId<Component>();
+	Archetype&		   l_archetype = *locations_[id].archetype;
+	if (!l_archetype.signature.test(l_id))
+	{
+		RESULT_ERROR(EcsComponentDataNotAdded);
+	}
+
+	// The component is not part of the target archetype, so it is destroyed by the move
+	(void)MoveEntity(id, Traverse(l_archetype, l_id));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+Component* ArchetypeRegistry<TypeList>::Get(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG(nullptr);
+	if (!IsEnabled<Component>(id))
+	{
+		RESULT_ERROR(EcsComponentNotEnabled, nullptr);
+	}
+	RESULT_OK();
+	const auto& [l_archetype, l_row] = locations_[id];
+	return static_cast<Component*>(l_archetype->At(GetComponentId<Component>(), l_row));
+}
+
+template<typename TypeList>
+template<typename Component, typename Function>
+void ArchetypeRegistry<TypeList>::Each(Function&& function, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	constexpr uint64_t l_id = GetComponentId<Component>();
+	for (Archetype& l_archetype : archetypes_)
+	{
+		if (!l_archetype.signature.test(l_id))
+		{
+			continue;
+		}
+		for (uint64_t l_chunk = 0; l_chunk * l_archetype.rows_per_chunk < l_archetype.size; ++l_chunk)
+		{
+			Component* const l_components = l_archetype.template Column<Component>(l_chunk);
+			const uint64_t	 l_count	  = l_archetype.ChunkSize(l_chunk);
+			for (uint64_t l_row = 0; l_row < l_count; ++l_row)
+			{
+				function(l_components[l_row]);
+			}
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components, typename Function>
+void ArchetypeRegistry<TypeList>::View(Function&& function, RESULT_PARAM_IMPL)
+{
+	static_assert(sizeof...(Components) > 0, "View needs at least one component type.");
+	RESULT_ENSURE_LAST_NOLOG();
+
+	signature_t l_mask{};
+	(l_mask.set(GetComponentId<Components>()), ...);
+
+	for (Archetype& l_archetype : archetypes_)
+	{
+		if ((l_archetype.signature & l_mask) != l_mask)
+		{
+			continue;
+		}
+		for (uint64_t l_chunk = 0; l_chunk * l_archetype.rows_per_chunk < l_archetype.size; ++l_chunk)
+		{
+			const entity_id_t* const			l_entities = l_archetype.Entities(l_chunk);
+			const eastl::tuple<Components*...> l_columns{l_archetype.template Column<Components>(l_chunk)...};
+			const uint64_t						l_count = l_archetype.ChunkSize(l_chunk);
+			for (uint64_t l_row = 0; l_row < l_count; ++l_row)
+			{
+				function(l_entities[l_row], eastl::get<Components*>(l_columns)[l_row]...);
+			}
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+uint64_t ArchetypeRegistry<TypeList>::Capacity(RESULT_PARAM_IMPL) const
+{
+	return entities_.Capacity();
+}
+
+template<typename TypeList>
+uint64_t ArchetypeRegistry<TypeList>::Size(RESULT_PARAM_IMPL) const
+{
+	return ecursor_;
+}
+
+template<typename TypeList>
+uint64_t ArchetypeRegistry<TypeList>::ArchetypeCount(RESULT_PARAM_IMPL) const
+{
+	return archetypes_.size();
+}
+
+template<typename TypeList>
+bool ArchetypeRegistry<TypeList>::Contains(const entity_id_t id, RESULT_PARAM_IMPL) const
+{
+	return id < Capacity();
+}
+
+template<typename TypeList>
+void ArchetypeRegistry<TypeList>::Reserve(const uint64_t capacity, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	while (Capacity() < capacity)
+	{
+		GrowEntities();
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+void ArchetypeRegistry<TypeList>::Clear(RESULT_PARAM_IMPL)
+{
+	ReleaseArchetypes();
+
+	entities_.Clear();
+	locations_.Clear();
+	ecursor_ = 0;
+	root_	 = &FindOrCreateArchetype(signature_t{});
+}
+
+template<typename TypeList>
+template<typename Component>
+constexpr uint64_t ArchetypeRegistry<TypeList>::GetComponentId()
+{
+	return TypeTraits::FindTupleType<Component, component_tuple_t>();
+}
+
+template<typename TypeList>
+typename ArchetypeRegistry<TypeList>::Archetype& ArchetypeRegistry<TypeList>::FindOrCreateArchetype(
+	const signature_t& signature)
+{
+	for (Archetype& l_archetype : archetypes_)
+	{
+		if (l_archetype.signature == signature)
+		{
+			return l_archetype;
+		}
+	}
+
+	archetypes_.push_back(Archetype{});
+	Archetype& l_archetype = archetypes_.back();
+	l_archetype.signature  = signature;
+	l_archetype.offsets.fill(0);
+
+	// Rows that fit in a chunk, the padding between columns is only known after the row count
+	uint64_t l_row_size = sizeof(entity_id_t);
+	for (uint64_t l_column = 0; l_column < components_t::SIZE; ++l_column)
+	{
+		if (signature.test(l_column))
+		{
+			l_row_size += column_table_t::VALUE[l_column].size;
+		}
+	}
+
+	for (uint64_t l_rows = ECS_ARCHETYPE_CHUNK_SIZE / l_row_size; l_rows > 0; --l_rows)
+	{
+		uint64_t l_offset = l_rows * sizeof(entity_id_t);
+		for (uint64_t l_column = 0; l_column < components_t::SIZE; ++l_column)
+		{
+			if (signature.test(l_column))
+			{
+				const auto& l_info			   = column_table_t::VALUE[l_column];
+				l_offset					   = (l_offset + l_info.alignment - 1) & ~(l_info.alignment - 1);
+				l_archetype.offsets[l_column] = l_offset;
+				l_offset += l_rows * l_info.size;
+			}
+		}
+		if (l_offset <= ECS_ARCHETYPE_CHUNK_SIZE)
+		{
+			l_archetype.rows_per_chunk = l_rows;
+			break;
+		}
+	}
+	return l_archetype;
+}
+
+template<typename TypeList>
+typename ArchetypeRegistry<TypeList>::Archetype& ArchetypeRegistry<TypeList>::Traverse(Archetype&	 archetype,
+																						const uint64_t component_id)
+{
+	if (!archetype.edges[component_id])
+	{
+		signature_t l_signature = archetype.signature;
+		l_signature.flip(component_id);
+
+		// Edges are cached in both directions, since the same component is added and removed back
+		Archetype& l_target				= FindOrCreateArchetype(l_signature);
+		archetype.edges[component_id]	= &l_target;
+		l_target.edges[component_id]	= &archetype;
+	}
+	return *archetype.edges[component_id];
+}
+
+template<typename TypeList>
+uint64_t ArchetypeRegistry<TypeList>::PushRow(Archetype& archetype, const entity_id_t id)
+{
+	const uint64_t l_row = archetype.size++;
+	if (l_row == archetype.chunks.size() * archetype.rows_per_chunk)
+	{
+		archetype.chunks.push_back(static_cast<uint8_t*>(
+			EASTLAllocatorType("Ecs").allocate(ECS_ARCHETYPE_CHUNK_SIZE, ECS_ARCHETYPE_CHUNK_ALIGNMENT, 0)));
+	}
+	archetype.Entities(l_row / archetype.rows_per_chunk)[l_row % archetype.rows_per_chunk] = id;
+	return l_row;
+}
+
+template<typename TypeList>
+void ArchetypeRegistry<TypeList>::RemoveRow(Archetype& archetype, const uint64_t row)
+{
+	// Swap and pop, the last row fills the hole. The components of the removed row are already gone
+	const uint64_t l_last = --archetype.size;
+	if (row != l_last)
+	{
+		for (uint64_t l_column = 0; l_column < components_t::SIZE; ++l_column)
+		{
+			if (archetype.signature.test(l_column))
+			{
+				column_table_t::VALUE[l_column].relocate(archetype.At(l_column, row), archetype.At(l_column, l_last));
+			}
+		}
+		const uint64_t	  l_rows		= archetype.rows_per_chunk;
+		const entity_id_t l_last_entity = archetype.Entities(l_last / l_rows)[l_last % l_rows];
+		archetype.Entities(row / l_rows)[row % l_rows] = l_last_entity;
+		locations_[l_last_entity].row					= row;
+	}
+}
+
+template<typename TypeList>
+uint64_t ArchetypeRegistry<TypeList>::MoveEntity(const entity_id_t id, Archetype& target)
+{
+	auto [l_source, l_source_row] = locations_[id];
+	const uint64_t l_target_row	  = PushRow(target, id);
+
+	for (uint64_t l_column = 0; l_column < components_t::SIZE; ++l_column)
+	{
+		if (!l_source->signature.test(l_column))
+		{
+			continue;
+		}
+		if (target.signature.test(l_column))
+		{
+			column_table_t::VALUE[l_column].relocate(target.At(l_column, l_target_row),
+													 l_source->At(l_column, l_source_row));
+		}
+		else
+		{
+			column_table_t::VALUE[l_column].destroy(l_source->At(l_column, l_source_row));
+		}
+	}
+
+	RemoveRow(*l_source, l_source_row);
+	locations_[id] = EntityLocation{&target, l_target_row};
+	return l_target_row;
+}
+
+template<typename TypeList>
+void ArchetypeRegistry<TypeList>::ReleaseArchetypes()
+{
+	for (Archetype& l_archetype : archetypes_)
+	{
+		for (uint64_t l_row = 0; l_row < l_archetype.size; ++l_row)
+		{
+			for (uint64_t l_column = 0; l_column < components_t::SIZE; ++l_column)
+			{
+				if (l_archetype.signature.test(l_column))
+				{
+					column_table_t::VALUE[l_column].destroy(l_archetype.At(l_column, l_row));
+				}
+			}
+		}
+		for (uint8_t* l_chunk : l_archetype.chunks)
+		{
+			EASTLAllocatorType("Ecs").deallocate(l_chunk, ECS_ARCHETYPE_CHUNK_SIZE);
+		}
+	}
+	archetypes_.clear();
+	root_ = nullptr;
+}
+
+template<typename TypeList>
+void ArchetypeRegistry<TypeList>::GrowEntities()
+{
+	const uint64_t	   l_page	  = entities_.PageCount();
+	const entity_id_t  l_first_id = l_page * PagedArray<entity_id_t>::PAGE_SIZE;
+	entity_id_t* const l_ids	  = entities_.AssurePage(l_page);
+	eastl::iota(l_ids, l_ids + PagedArray<entity_id_t>::PAGE_SIZE, l_first_id);
+	locations_.AssurePage(l_page, EntityLocation{nullptr, 0});
+}
+
+} // namespace Ecs
+
+#endif
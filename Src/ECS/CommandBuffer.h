@@ -0,0 +1,446 @@
+/** @file CommandBuffer.h
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#ifndef ECS_COMMAND_BUFFER_H
+#define ECS_COMMAND_BUFFER_H
+
+#include "Core/Common.h"
+#include "Core/Allocator.h"
+#include "ECS/Registry.h"
+
+#include <EASTL/sort.h>
+
+#ifndef ECS_COMMAND_BLOCK_SIZE
+#define ECS_COMMAND_BLOCK_SIZE 65536ull
+#endif
+
+namespace Ecs
+{
+
+/**
+ * @brief Command buffer class.
+ *
+ * Records structural changes of a @ref Registry to apply them later with @ref Registry::Playback.
+ * A buffer is not thread safe, the intended use is one buffer per worker thread (or per system), recorded while
+ * the registry is shared read-only by parallel systems.
+ *
+ * Data:
+ * 1. Blocks of @ref ECS_COMMAND_BLOCK_SIZE bytes, commands and their components are linearly allocated inside.
+ *	Blocks are kept by @ref Clear, so a buffer stops allocating once it reached its peak size.
+ *
+ * Behavior:
+ * 1. @ref Create returns a pending id, it can be the target of the next commands of the same buffer.
+ * 2. Components are moved into the buffer, and moved out to the registry on playback.
+ * 3. Commands carry the current sort key (@ref SetSortKey), playback orders them by it.
+ *
+ * @tparam TypeList Component type list of the target registry.
+ *
+ */
+template<typename TypeList>
+class CommandBuffer final
+{
+	friend class Registry<TypeList>;
+
+public:
+	using registry_t = Registry<TypeList>;
+
+	/**
+	 * @brief Bit of the ids returned by @ref Create, the other bits are the creation index inside the buffer.
+	 */
+	static constexpr entity_id_t PENDING_ENTITY_FLAG = entity_id_t{1} << (sizeof(entity_id_t) * 8 - 1);
+
+public:
+	EXPLICIT CommandBuffer(uint64_t block_size = ECS_COMMAND_BLOCK_SIZE);
+
+	CommandBuffer(CommandBuffer&& other) NOEXCEPT;
+	CommandBuffer(const CommandBuffer&) = delete;
+	CommandBuffer& operator=(CommandBuffer&& other) NOEXCEPT;
+	CommandBuffer& operator=(const CommandBuffer&) = delete;
+	~CommandBuffer();
+
+public:
+	/**
+	 * @brief Record an entity creation.
+	 *
+	 * @return Pending id, only valid as target of commands of this buffer.
+	 *
+	 */
+	entity_id_t Create();
+
+	void Destroy(entity_id_t id);
+
+	template<typename Component>
+	void Add(entity_id_t id, Component&& component);
+
+	template<typename Component>
+	void Remove(entity_id_t id);
+
+	/**
+	 * @brief Sort key of the next commands.
+	 *
+	 * Keying commands by something stable, like the entity that a parallel system was processing, makes playback
+	 * independent of which thread recorded which command.
+	 *
+	 */
+	void SetSortKey(uint64_t key);
+
+	NODISCARD uint64_t Size() const;
+	NODISCARD bool	   IsEmpty() const;
+
+	/**
+	 * @brief Drop every command that was not applied, the blocks are kept.
+	 */
+	void Clear();
+
+private:
+	enum CommandType : uint32_t
+	{
+		eCreate,
+		eDestroy,
+		eAdd,
+		eRemove
+	};
+
+	using apply_function_t	 = void (*)(registry_t& registry, entity_id_t id, void* payload, RESULT_PARAM_IMPL);
+	using destroy_function_t = void (*)(void* payload);
+
+	struct Command
+	{
+		apply_function_t   apply;
+		destroy_function_t destroy;
+		uint64_t		   key;
+		entity_id_t		   entity;
+		uint32_t		   size;
+		uint32_t		   payload;
+		CommandType		   type;
+	};
+
+	struct Block
+	{
+		uint8_t* data;
+		uint64_t size;
+		uint64_t used;
+	};
+
+	template<typename Component>
+	static void ApplyAdd(registry_t& registry, entity_id_t id, void* payload, RESULT_PARAM_IMPL);
+
+	template<typename Component>
+	static void ApplyRemove(registry_t& registry, entity_id_t id, void* payload, RESULT_PARAM_IMPL);
+
+	template<typename Component>
+	static void DestroyPayload(void* payload);
+
+	/**
+	 * @brief Allocate a command followed by payload_size bytes aligned to payload_alignment.
+	 */
+	Command* Push(CommandType type, entity_id_t id, uint64_t payload_size, uint64_t payload_alignment);
+
+	template<typename Function>
+	void EachCommand(Function&& function);
+
+	void Release();
+
+private:
+	eastl::vector<Block> blocks_;
+	uint64_t			 block_{};
+	uint64_t			 block_size_{};
+	uint64_t			 size_{};
+	uint64_t			 pending_{};
+	uint64_t			 key_{};
+};
+
+template<typename TypeList>
+CommandBuffer<TypeList>::CommandBuffer(const uint64_t block_size) : block_size_{block_size}
+{
+}
+
+template<typename TypeList>
+CommandBuffer<TypeList>::CommandBuffer(CommandBuffer&& other) NOEXCEPT
+	: blocks_{eastl::move(other.blocks_)}, block_{other.block_}, block_size_{other.block_size_}, size_{other.size_},
+	  pending_{other.pending_}, key_{other.key_}
+{
+	other.blocks_.clear();
+	other.block_ = other.size_ = other.pending_ = other.key_ = 0;
+}
+
+template<typename TypeList>
+CommandBuffer<TypeList>& CommandBuffer<TypeList>::operator=(CommandBuffer&& other) NOEXCEPT
+{
+	Release();
+	blocks_		= eastl::move(other.blocks_);
+	block_		= other.block_;
+	block_size_ = other.block_size_;
+	size_		= other.size_;
+	pending_	= other.pending_;
+	key_		= other.key_;
+	other.blocks_.clear();
+	other.block_ = other.size_ = other.pending_ = other.key_ = 0;
+	return *this;
+}
+
+template<typename TypeList>
+CommandBuffer<TypeList>::~CommandBuffer()
+{
+	Release();
+}
+
+template<typename TypeList>
+entity_id_t CommandBuffer<TypeList>::Create()
+{
+	const entity_id_t l_id = PENDING_ENTITY_FLAG | pending_++;
+	Push(eCreate, l_id, 0, 1);
+	return l_id;
+}
+
+template<typename TypeList>
+void CommandBuffer<TypeList>::Destroy(const entity_id_t id)
+{
+	Push(eDestroy, id, 0, 1);
+}
+
+template<typename TypeList>
+template<typename Component>
+void CommandBuffer<TypeList>::Add(const entity_id_t id, Component&& component)
+{
+	Command* l_command = Push(eAdd, id, sizeof(Component), alignof(Component));
+	l_command->apply   = &ApplyAdd<Component>;
+	if constexpr (!eastl::is_trivially_destructible_v<Component>)
+	{
+		l_command->destroy = &DestroyPayload<Component>;
+	}
+	new (reinterpret_cast<uint8_t*>(l_command) + l_command->payload) Component{eastl::move(component)};
+}
+
+template<typename TypeList>
+template<typename Component>
+void CommandBuffer<TypeList>::Remove(const entity_id_t id)
+{
+	Command* l_command = Push(eRemove, id, 0, 1);
+	l_command->apply   = &ApplyRemove<Component>;
+}
+
+template<typename TypeList>
+void CommandBuffer<TypeList>::SetSortKey(const uint64_t key)
+{
+	key_ = key;
+}
+
+template<typename TypeList>
+uint64_t CommandBuffer<TypeList>::Size() const
+{
+	return size_;
+}
+
+template<typename TypeList>
+bool CommandBuffer<TypeList>::IsEmpty() const
+{
+	return size_ == 0;
+}
+
+template<typename TypeList>
+void CommandBuffer<TypeList>::Clear()
+{
+	EachCommand([](Command& command) {
+		if (command.destroy)
+		{
+			command.destroy(reinterpret_cast<uint8_t*>(&command) + command.payload);
+		}
+	});
+	for (Block& l_block : blocks_)
+	{
+		l_block.used = 0;
+	}
+	block_ = size_ = pending_ = key_ = 0;
+}
+
+template<typename TypeList>
+template<typename Component>
+void CommandBuffer<TypeList>::ApplyAdd(registry_t& registry, const entity_id_t id, void* payload, RESULT_PARAM_IMPL)
+{
+	Component* l_component = static_cast<Component*>(payload);
+	registry.Add(id, eastl::move(*l_component), RESULT_ARG_PASS);
+	l_component->~Component();
+}
+
+template<typename TypeList>
+template<typename Component>
+void CommandBuffer<TypeList>::ApplyRemove(registry_t& registry, const entity_id_t id, void*, RESULT_PARAM_IMPL)
+{
+	registry.template Remove<Component>(id, RESULT_ARG_PASS);
+}
+
+template<typename TypeList>
+template<typename Component>
+void CommandBuffer<TypeList>::DestroyPayload(void* payload)
+{
+	static_cast<Component*>(payload)->~Component();
+}
+
+template<typename TypeList>
+typename CommandBuffer<TypeList>::Command* CommandBuffer<TypeList>::Push(const CommandType type, const entity_id_t id,
+																		  const uint64_t payload_size,
+																		  const uint64_t payload_alignment)
+{
+	// Blocks start at a cache line, so the padding before the payload only depends on the offset inside the block
+	const auto l_layout = [&](const uint64_t offset) {
+		const uint64_t l_payload = Memory::Align(offset + sizeof(Command), payload_alignment) - offset;
+		return eastl::make_pair(l_payload, Memory::Align(l_payload + payload_size, alignof(Command)));
+	};
+
+	while (block_ < blocks_.size() &&
+		   blocks_[block_].used + l_layout(blocks_[block_].used).second > blocks_[block_].size)
+	{
+		++block_;
+	}
+	if (block_ == blocks_.size())
+	{
+		const uint64_t l_block_size = eastl::max(block_size_, l_layout(0).second);
+		auto l_data = static_cast<uint8_t*>(EASTLAllocatorType("Ecs").allocate(l_block_size, CACHE_LINE_SIZE, 0));
+		blocks_.push_back(Block{l_data, l_block_size, 0});
+	}
+
+	Block&		   l_block			   = blocks_[block_];
+	const auto	   [l_payload, l_size] = l_layout(l_block.used);
+	Command* const l_command		   = reinterpret_cast<Command*>(l_block.data + l_block.used);
+	new (l_command)
+		Command{nullptr, nullptr, key_, id, static_cast<uint32_t>(l_size), static_cast<uint32_t>(l_payload), type};
+	l_block.used += l_size;
+	++size_;
+	return l_command;
+}
+
+template<typename TypeList>
+template<typename Function>
+void CommandBuffer<TypeList>::EachCommand(Function&& function)
+{
+	for (uint64_t l_block = 0; l_block < blocks_.size() && l_block <= block_; ++l_block)
+	{
+		const Block& l_data = blocks_[l_block];
+		for (uint64_t l_offset = 0; l_offset < l_data.used;)
+		{
+			Command& l_command = *reinterpret_cast<Command*>(l_data.data + l_offset);
+			l_offset += l_command.size;
+			function(l_command);
+		}
+	}
+}
+
+template<typename TypeList>
+void CommandBuffer<TypeList>::Release()
+{
+	Clear();
+	for (const Block& l_block : blocks_)
+	{
+		EASTLAllocatorType("Ecs").deallocate(l_block.data, l_block.size);
+	}
+	blocks_.clear();
+}
+
+template<typename TypeList>
+void Registry<TypeList>::Playback(CommandBuffer<TypeList>& buffer, RESULT_PARAM_IMPL)
+{
+	CommandBuffer<TypeList>* l_buffers[] = {&buffer};
+	Playback(eastl::span<CommandBuffer<TypeList>* const>{l_buffers}, RESULT_ARG_PASS);
+}
+
+template<typename TypeList>
+void Registry<TypeList>::Playback(const eastl::span<CommandBuffer<TypeList>* const> buffers, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	PlaybackInternal(buffers, RESULT_ARG_PASS);
+
+	// Commands that were not applied because of an error are dropped too
+	for (CommandBuffer<TypeList>* l_buffer : buffers)
+	{
+		l_buffer->Clear();
+	}
+}
+
+template<typename TypeList>
+void Registry<TypeList>::PlaybackInternal(const eastl::span<CommandBuffer<TypeList>* const> buffers,
+										  RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	using buffer_t	= CommandBuffer<TypeList>;
+	using command_t = typename buffer_t::Command;
+
+	struct Entry
+	{
+		uint64_t   key;
+		uint64_t   pending_base;
+		command_t* command;
+	};
+
+	// Gathered by buffer and recording order, the stable sort keeps it for equal keys
+	uint64_t l_count   = 0;
+	uint64_t l_pending = 0;
+	for (const buffer_t* l_buffer : buffers)
+	{
+		l_count += l_buffer->Size();
+	}
+	eastl::vector<Entry> l_entries;
+	l_entries.reserve(l_count);
+	for (buffer_t* l_buffer : buffers)
+	{
+		l_buffer->EachCommand(
+			[&](command_t& command) { l_entries.push_back(Entry{command.key, l_pending, &command}); });
+		l_pending += l_buffer->pending_;
+	}
+
+	const auto l_by_key = [](const Entry& a, const Entry& b) { return a.key < b.key; };
+	if (!eastl::is_sorted(l_entries.begin(), l_entries.end(), l_by_key))
+	{
+		eastl::stable_sort(l_entries.begin(), l_entries.end(), l_by_key);
+	}
+
+	// Entities are created first, so commands can target them whatever their key
+	eastl::vector<entity_id_t> l_created(l_pending, INVALID_ENTITY_ID);
+	for (const Entry& l_entry : l_entries)
+	{
+		if (l_entry.command->type == buffer_t::eCreate)
+		{
+			const uint64_t l_index = l_entry.pending_base + (l_entry.command->entity & ~buffer_t::PENDING_ENTITY_FLAG);
+			RESULT_ENSURE_CALL_NOLOG(l_created[l_index] = Create(RESULT_ARG_PASS));
+		}
+	}
+
+	for (const Entry& l_entry : l_entries)
+	{
+		command_t& l_command = *l_entry.command;
+		entity_id_t l_id	 = l_command.entity;
+		if (l_id != INVALID_ENTITY_ID && (l_id & buffer_t::PENDING_ENTITY_FLAG))
+		{
+			l_id = l_created[l_entry.pending_base + (l_id & ~buffer_t::PENDING_ENTITY_FLAG)];
+		}
+
+		switch (l_command.type)
+		{
+		case buffer_t::eCreate:
+			break;
+		case buffer_t::eDestroy:
+			RESULT_ENSURE_CALL_NOLOG(Destroy(l_id, RESULT_ARG_PASS));
+			break;
+		case buffer_t::eAdd:
+			// The payload is consumed even if the registry refuses it
+			l_command.destroy = nullptr;
+			RESULT_ENSURE_CALL_NOLOG(
+				l_command.apply(*this, l_id, reinterpret_cast<uint8_t*>(&l_command) + l_command.payload,
+								RESULT_ARG_PASS));
+			break;
+		case buffer_t::eRemove:
+			RESULT_ENSURE_CALL_NOLOG(l_command.apply(*this, l_id, nullptr, RESULT_ARG_PASS));
+			break;
+		}
+	}
+	RESULT_OK();
+}
+
+} // namespace Ecs
+
+#endif
@@ -13,6 +13,7 @@
 #include <EASTL/string.h>
 
 #include "Core/Common.h"
+#include "Core/Stream.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -28,6 +29,20 @@ public:
 	/*TYPE_INFO_DEFINE(NAME);*/                                                                                        \
 	static_assert(!eastl::is_polymorphic_v<NAME>, "The component class cannot be polymorphic.");
 
+/**
+ * @brief Selects the registry storage of a component type.
+ *
+ * Must be used at global namespace, after the component declaration.
+ * Ex: ECS_COMPONENT_STORAGE(Game::ProjectileComponent, eDense)
+ *
+ */
+#define ECS_COMPONENT_STORAGE(NAME, STORAGE)                                                                           \
+	template<>                                                                                                         \
+	struct Ecs::ComponentStorageOf<NAME>                                                                               \
+	{                                                                                                                  \
+		static constexpr Ecs::ComponentStorage::Type VALUE = Ecs::ComponentStorage::STORAGE;                           \
+	};
+
 #ifndef COMPONENT_ID_TYPE
 #define COMPONENT_ID_TYPE u64
 #endif
@@ -47,6 +62,119 @@ struct IsComponent<T, eastl::void_t<typename T::EcsComponentType>>
 	static constexpr bool VALUE = true;
 };
 
+namespace ComponentStorage
+{
+enum Type
+{
+	/**
+	 * @brief Removed components leave a hole that is reused by a free list. Indices are stable.
+	 */
+	eSparse,
+	/**
+	 * @brief Components are kept contiguous with swap-and-pop removal. Indices are not stable.
+	 */
+	eDense,
+	/**
+	 * @brief The glm::vec3 value of the component is split in x, y and z streams indexed by entity id.
+	 * Components have no address, see @ref SoaStreams.
+	 */
+	eSoa,
+	/**
+	 * @brief Equal values are stored once with a reference count, entities hold a 32-bit index to their value.
+	 * Components have no address and must be trivially copyable, see @ref SharedComponentTraits.
+	 */
+	eShared
+};
+} // namespace ComponentStorage
+
+template<typename T, typename = void>
+struct ComponentStorageOf
+{
+	static constexpr ComponentStorage::Type VALUE = ComponentStorage::eSparse;
+};
+
+/**
+ * @brief Empty components are tags, they only exist as a bit of the entity signature and have no storage.
+ */
+template<typename T>
+struct IsTagComponent
+{
+	static constexpr bool VALUE = eastl::is_empty_v<T>;
+};
+
+template<typename T>
+struct IsSoaComponent
+{
+	static constexpr bool VALUE = ComponentStorageOf<T>::VALUE == ComponentStorage::eSoa;
+};
+
+template<typename T>
+struct IsSharedComponent
+{
+	static constexpr bool VALUE = ComponentStorageOf<T>::VALUE == ComponentStorage::eShared;
+};
+
+namespace Detail
+{
+
+inline uint64_t HashBytes(const void* data, const uint64_t size)
+{
+	const auto*	  l_bytes = static_cast<const uint8_t*>(data);
+	Hash::fnv1a_t l_hash  = Hash::FNV_BASIS;
+	for (uint64_t l_index = 0; l_index < size; ++l_index)
+	{
+		l_hash = (l_hash ^ l_bytes[l_index]) * Hash::FNV_PRIME;
+	}
+	return l_hash;
+}
+
+} // namespace Detail
+
+/**
+ * @brief Hash and equality of @ref ComponentStorage::eShared values.
+ *
+ * The bytes of the value member are compared, or the bytes of the whole component when it has no value member.
+ * Components whose compared bytes hold padding must specialize it.
+ *
+ */
+template<typename T, typename = void>
+struct SharedComponentTraits
+{
+	static uint64_t Hash(const T& component)
+	{
+		return Detail::HashBytes(&component, sizeof(T));
+	}
+
+	static bool Equal(const T& first, const T& second)
+	{
+		return memcmp(&first, &second, sizeof(T)) == 0;
+	}
+};
+
+template<typename T>
+struct SharedComponentTraits<T, eastl::void_t<decltype(T::value)>>
+{
+	static uint64_t Hash(const T& component)
+	{
+		return Detail::HashBytes(&component.value, sizeof component.value);
+	}
+
+	static bool Equal(const T& first, const T& second)
+	{
+		return memcmp(&first.value, &second.value, sizeof first.value) == 0;
+	}
+};
+
+/**
+ * @brief x, y and z streams of one page of a @ref ComponentStorage::eSoa component.
+ */
+struct SoaStreams
+{
+	float32_t* x;
+	float32_t* y;
+	float32_t* z;
+};
+
 namespace Detail
 {
 
@@ -124,195 +252,259 @@ struct ALIGNAS(16) NameComponent
 
 struct PlaceholderComponent0
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent0);
 };
 struct PlaceholderComponent1
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent1);
 };
 struct PlaceholderComponent2
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent2);
 };
 struct PlaceholderComponent3
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent3);
 };
 struct PlaceholderComponent4
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent4);
 };
 struct PlaceholderComponent5
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent5);
 };
 struct PlaceholderComponent6
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent6);
 };
 struct PlaceholderComponent7
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent7);
 };
 struct PlaceholderComponent8
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent8);
 };
 struct PlaceholderComponent9
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent9);
 };
 struct PlaceholderComponent10
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent10);
 };
 struct PlaceholderComponent11
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent11);
 };
 struct PlaceholderComponent12
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent12);
 };
 struct PlaceholderComponent13
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent13);
 };
 struct PlaceholderComponent14
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent14);
 };
 struct PlaceholderComponent15
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent15);
 };
 struct PlaceholderComponent16
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent16);
 };
 struct PlaceholderComponent17
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent17);
 };
 struct PlaceholderComponent18
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent18);
 };
 struct PlaceholderComponent19
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent19);
 };
 struct PlaceholderComponent20
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent20);
 };
 struct PlaceholderComponent21
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent21);
 };
 struct PlaceholderComponent22
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent22);
 };
 struct PlaceholderComponent23
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent23);
 };
 struct PlaceholderComponent24
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent24);
 };
 struct PlaceholderComponent25
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent25);
 };
 struct PlaceholderComponent26
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent26);
 };
 struct PlaceholderComponent27
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent27);
 };
 struct PlaceholderComponent28
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent28);
 };
 struct PlaceholderComponent29
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent29);
 };
 struct PlaceholderComponent30
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent30);
 };
 struct PlaceholderComponent31
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent31);
 };
 struct PlaceholderComponent32
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent32);
 };
 struct PlaceholderComponent33
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent33);
 };
 struct PlaceholderComponent34
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent34);
 };
 struct PlaceholderComponent35
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent35);
 };
 struct PlaceholderComponent36
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent36);
 };
 struct PlaceholderComponent37
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent37);
 };
 struct PlaceholderComponent38
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent38);
 };
 struct PlaceholderComponent39
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent39);
 };
 struct PlaceholderComponent40
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent40);
 };
 struct PlaceholderComponent41
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent41);
 };
 struct PlaceholderComponent42
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent42);
 };
 struct PlaceholderComponent43
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent43);
 };
 struct PlaceholderComponent44
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent44);
 };
 struct PlaceholderComponent45
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent45);
 };
 struct PlaceholderComponent46
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent46);
 };
 struct PlaceholderComponent47
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent47);
 };
 struct PlaceholderComponent48
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent48);
 };
 struct PlaceholderComponent49
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent49);
 };
 struct PlaceholderComponent50
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent50);
 };
 struct PlaceholderComponent51
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent51);
 };
 struct PlaceholderComponent52
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent52);
 };
 struct PlaceholderComponent53
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent53);
 };
 struct PlaceholderComponent54
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent54);
 };
 struct PlaceholderComponent55
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent55);
 };
 struct PlaceholderComponent56
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent56);
 };
 struct PlaceholderComponent57
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent57);
 };
 struct PlaceholderComponent58
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent58);
 };
 struct PlaceholderComponent59
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent59);
 };
 struct PlaceholderComponent60
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent60);
 };
 struct PlaceholderComponent61
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent61);
 };
 struct PlaceholderComponent62
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent62);
 };
 struct PlaceholderComponent63
 {
+	ECS_COMPONENT_BODY(PlaceholderComponent63);
 };
 
 using TranformComponentTypes   = TypeTraits::TypeList<LocationComponent, RotationComponent, ScaleComponent>;
@@ -343,7 +535,7 @@ using Placeholder64ComponentTypes =
 						 PlaceholderComponent40, PlaceholderComponent41, PlaceholderComponent42, PlaceholderComponent43,
 						 PlaceholderComponent44, PlaceholderComponent45, PlaceholderComponent46, PlaceholderComponent47,
 						 PlaceholderComponent48, PlaceholderComponent49, PlaceholderComponent50, PlaceholderComponent51,
-						 PlaceholderComponent52, PlaceholderComponent33, PlaceholderComponent54, PlaceholderComponent55,
+						 PlaceholderComponent52, PlaceholderComponent53, PlaceholderComponent54, PlaceholderComponent55,
 						 PlaceholderComponent56, PlaceholderComponent57, PlaceholderComponent58, PlaceholderComponent59,
 						 PlaceholderComponent60, PlaceholderComponent61, PlaceholderComponent62,
 						 PlaceholderComponent63>;
@@ -357,4 +549,29 @@ ECS_COMPONENT_VALIDATION(Ecs::Location2dComponent)
 ECS_COMPONENT_VALIDATION(Ecs::Rotation2dComponent);
 ECS_COMPONENT_VALIDATION(Ecs::Scale2dComponent);
 
+// Length and characters only, so empty names round trip too
+STREAM_IMPL_BEGIN(Ecs::NameComponent)
+STREAM_WRITE_IMPL_VALUE_FUNCTION_BEGIN()
+const uint64_t l_size = value.value.size();
+RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&l_size, sizeof l_size, RESULT_ARG_PASS), StreamFailedToWrite,
+							  false);
+if (l_size)
+{
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(value.value.data(), l_size, RESULT_ARG_PASS),
+								  StreamFailedToWrite, false);
+}
+STREAM_IMPL_VALUE_FUNCTION_END()
+STREAM_READ_IMPL_VALUE_FUNCTION_BEGIN()
+uint64_t l_size{};
+RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_size, sizeof l_size, RESULT_ARG_PASS), StreamFailedToRead,
+							  false);
+value.value.resize(l_size);
+if (l_size)
+{
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(value.value.data(), l_size, RESULT_ARG_PASS), StreamFailedToRead,
+								  false);
+}
+STREAM_IMPL_VALUE_FUNCTION_END()
+STREAM_IMPL_END()
+
 #endif
@@ -0,0 +1,634 @@
+/** @file PagedArray.h
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#ifndef ECS_PAGED_ARRAY_H
+#define ECS_PAGED_ARRAY_H
+
+#include "Core/Common.h"
+#include "Core/Allocator.h"
+
+#include <EASTL/atomic.h>
+
+#ifndef ECS_PAGE_SIZE
+#define ECS_PAGE_SIZE 4096ull
+#endif
+
+/**
+ * @brief Bytes compared and written as a unit by @ref PagedArray::SaveDelta.
+ */
+#ifndef ECS_DELTA_BLOCK_SIZE
+#define ECS_DELTA_BLOCK_SIZE 256ull
+#endif
+
+namespace Ecs
+{
+
+/**
+ * @brief Paged array class.
+ *
+ * Array split in fixed size pages that are allocated on demand.
+ * Pages are never moved, so pointers to elements stay valid while the array grows.
+ * Elements are not constructed or destroyed, that is responsibility of the owner (like @ref RawBuffer).
+ * Arrays of trivially copyable elements can be written to a stream and read back as raw pages (@ref Save), and
+ * shared copy-on-write with another array (@ref Share).
+ *
+ * @tparam T Element type.
+ * @tparam PageSize Elements per page. Must be a power of two.
+ *
+ */
+template<typename T, uint64_t PageSize = ECS_PAGE_SIZE>
+class PagedArray final
+{
+	static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "Page size must be a power of two.");
+
+public:
+	static constexpr uint64_t PAGE_SIZE = PageSize;
+
+	/**
+	 * @brief Pages start at a cache line, so ranges of whole cache lines do not share lines between pages.
+	 */
+	static constexpr uint64_t PAGE_ALIGNMENT = alignof(T) > CACHE_LINE_SIZE ? alignof(T) : CACHE_LINE_SIZE;
+
+	/**
+	 * @brief Minimum element count that spans whole cache lines.
+	 */
+	static constexpr uint64_t CACHE_LINE_ELEMENTS =
+		CACHE_LINE_SIZE / (CACHE_LINE_SIZE < (sizeof(T) & (~sizeof(T) + 1)) ? CACHE_LINE_SIZE : (sizeof(T) & (~sizeof(T) + 1)));
+
+public:
+	PagedArray() = default;
+	PagedArray(PagedArray&& other) NOEXCEPT;
+	PagedArray& operator=(PagedArray&& other) NOEXCEPT;
+	PagedArray(const PagedArray&)			 = delete;
+	PagedArray& operator=(const PagedArray&) = delete;
+	~PagedArray();
+
+public:
+	NODISCARD static constexpr uint64_t PageOf(uint64_t index);
+	NODISCARD static constexpr uint64_t OffsetOf(uint64_t index);
+
+	/**
+	 * @brief Get page, allocating it if needed.
+	 *
+	 * @param page Page index.
+	 * @return Page memory.
+	 *
+	 */
+	T* AssurePage(uint64_t page);
+
+	/**
+	 * @brief Get page, allocating it and filling with a value if needed.
+	 *
+	 * @param page Page index.
+	 * @param fill Value copied to every element of a new page.
+	 * @return Page memory.
+	 *
+	 */
+	T* AssurePage(uint64_t page, const T& fill);
+
+	NODISCARD T*	   Page(uint64_t page);
+	NODISCARD const T* Page(uint64_t page) const;
+	NODISCARD uint64_t PageCount() const;
+	NODISCARD uint64_t Capacity() const;
+
+	/**
+	 * @brief Bytes of the allocated pages, headers included, and of the directory.
+	 *
+	 * Pages shared with other arrays (@ref Share) are counted by every array.
+	 *
+	 */
+	NODISCARD uint64_t Bytes() const;
+
+	NODISCARD T*	   TryGet(uint64_t index);
+	NODISCARD const T* TryGet(uint64_t index) const;
+
+	NODISCARD T&	   operator[](uint64_t index);
+	NODISCARD const T& operator[](uint64_t index) const;
+
+	void Clear();
+
+	/**
+	 * @brief Write the elements [0, count) to a stream, one raw block per page.
+	 *
+	 * Pages that are not allocated are written as a flag only.
+	 *
+	 * @param stream Target stream (see Core/Stream.h).
+	 * @param count Elements to write, the pages that hold them must be allocated or be unused.
+	 *
+	 */
+	template<typename StreamType>
+	void Save(StreamType& stream, uint64_t count, RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief Read the pages written by @ref Save, the array must be empty.
+	 */
+	template<typename StreamType>
+	void Load(StreamType& stream, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Share every page with a new array, copy-on-write.
+	 *
+	 * Both arrays read the same pages until one of them asks for a mutable page (mutable @ref Page, @ref TryGet,
+	 * @ref AssurePage or operator[]), which copies that page first, so each array keeps the content of the moment of
+	 * the share. Pointers taken before the share must not be written after it.
+	 * Pages are reference counted, so the two arrays can be used and destroyed by different threads. The copy of a
+	 * page is not thread safe, threads that take mutable pages of the same array at once need @ref UnshareAll first.
+	 *
+	 * @return Array with the same pages.
+	 *
+	 */
+	NODISCARD PagedArray Share();
+
+	/**
+	 * @brief Copy every page still shared (@ref Share), so mutable pages can be taken concurrently.
+	 */
+	void UnshareAll();
+
+	/**
+	 * @brief Write the difference of the elements [0, count) against a baseline array.
+	 *
+	 * Pages still shared with the baseline (@ref Share) are skipped without a compare, other pages are compared in
+	 * blocks of @ref ECS_DELTA_BLOCK_SIZE bytes and only the blocks that differ are written. When a page of the
+	 * baseline is missing here (the array was cleared) the whole array is written, like @ref Save.
+	 *
+	 * @param baseline Array state the delta is applied to.
+	 * @param stream Target stream.
+	 * @param count Elements to compare.
+	 *
+	 */
+	template<typename StreamType>
+	void SaveDelta(const PagedArray& baseline, StreamType& stream, uint64_t count, RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief Apply a delta written by @ref SaveDelta, the array must be in the state of the baseline.
+	 */
+	template<typename StreamType>
+	void LoadDelta(StreamType& stream, RESULT_PARAM_DEFINE);
+
+private:
+	enum DeltaPage : uint8_t
+	{
+		eDeltaSkip,
+		eDeltaBlocks,
+		eDeltaPage
+	};
+
+	static constexpr uint64_t DELTA_BLOCK_SIZE	= ECS_DELTA_BLOCK_SIZE;
+	static constexpr uint64_t DELTA_BLOCK_COUNT = (PageSize * sizeof(T) + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+	static constexpr uint64_t DELTA_MASK_WORDS	= (DELTA_BLOCK_COUNT + 63) / 64;
+
+	/**
+	 * @brief Header in front of every page.
+	 */
+	struct PageHeader
+	{
+		eastl::atomic<uint32_t> references;
+	};
+
+	/**
+	 * @brief Bit of a directory entry set while the page may be shared.
+	 */
+	static constexpr uintptr_t SHARED_TAG  = 1;
+	static constexpr uint64_t  HEADER_SIZE = PAGE_ALIGNMENT;
+
+	static T*		   PageOfEntry(uintptr_t entry);
+	static PageHeader* HeaderOf(const T* page);
+	static T*		   AllocatePage();
+	static void		   ReleasePage(T* page);
+
+	T*	 Unshare(uint64_t page);
+	void GrowDirectory(uint64_t page_count);
+
+private:
+	uintptr_t* pages_{};
+	uint64_t   page_count_{};
+};
+
+template<typename T, uint64_t PageSize>
+PagedArray<T, PageSize>::PagedArray(PagedArray&& other) NOEXCEPT : pages_{other.pages_}, page_count_{other.page_count_}
+{
+	other.pages_	  = nullptr;
+	other.page_count_ = 0;
+}
+
+template<typename T, uint64_t PageSize>
+PagedArray<T, PageSize>& PagedArray<T, PageSize>::operator=(PagedArray&& other) NOEXCEPT
+{
+	Clear();
+	pages_			  = other.pages_;
+	page_count_		  = other.page_count_;
+	other.pages_	  = nullptr;
+	other.page_count_ = 0;
+	return *this;
+}
+
+template<typename T, uint64_t PageSize>
+PagedArray<T, PageSize>::~PagedArray()
+{
+	Clear();
+}
+
+template<typename T, uint64_t PageSize>
+constexpr uint64_t PagedArray<T, PageSize>::PageOf(const uint64_t index)
+{
+	return index / PageSize;
+}
+
+template<typename T, uint64_t PageSize>
+constexpr uint64_t PagedArray<T, PageSize>::OffsetOf(const uint64_t index)
+{
+	return index & (PageSize - 1);
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::AssurePage(const uint64_t page)
+{
+	if (page >= page_count_)
+	{
+		GrowDirectory(page + 1);
+	}
+	if (!pages_[page])
+	{
+		pages_[page] = reinterpret_cast<uintptr_t>(AllocatePage());
+	}
+	return Page(page);
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::AssurePage(const uint64_t page, const T& fill)
+{
+	if (page < page_count_ && pages_[page])
+	{
+		return Page(page);
+	}
+	T* l_page = AssurePage(page);
+	eastl::uninitialized_fill_n(l_page, PageSize, fill);
+	return l_page;
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::Page(const uint64_t page)
+{
+	if (page >= page_count_)
+	{
+		return nullptr;
+	}
+	return pages_[page] & SHARED_TAG ? Unshare(page) : PageOfEntry(pages_[page]);
+}
+
+template<typename T, uint64_t PageSize>
+const T* PagedArray<T, PageSize>::Page(const uint64_t page) const
+{
+	return page < page_count_ ? PageOfEntry(pages_[page]) : nullptr;
+}
+
+template<typename T, uint64_t PageSize>
+uint64_t PagedArray<T, PageSize>::PageCount() const
+{
+	return page_count_;
+}
+
+template<typename T, uint64_t PageSize>
+uint64_t PagedArray<T, PageSize>::Capacity() const
+{
+	return page_count_ * PageSize;
+}
+
+template<typename T, uint64_t PageSize>
+uint64_t PagedArray<T, PageSize>::Bytes() const
+{
+	uint64_t l_bytes = page_count_ * sizeof(uintptr_t);
+	for (uint64_t l_page = 0; l_page < page_count_; ++l_page)
+	{
+		if (pages_[l_page])
+		{
+			l_bytes += HEADER_SIZE + PageSize * sizeof(T);
+		}
+	}
+	return l_bytes;
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::TryGet(const uint64_t index)
+{
+	T* l_page = Page(PageOf(index));
+	return l_page ? l_page + OffsetOf(index) : nullptr;
+}
+
+template<typename T, uint64_t PageSize>
+const T* PagedArray<T, PageSize>::TryGet(const uint64_t index) const
+{
+	const T* l_page = Page(PageOf(index));
+	return l_page ? l_page + OffsetOf(index) : nullptr;
+}
+
+template<typename T, uint64_t PageSize>
+T& PagedArray<T, PageSize>::operator[](const uint64_t index)
+{
+	const uint64_t l_page = PageOf(index);
+	return (pages_[l_page] & SHARED_TAG ? Unshare(l_page) : PageOfEntry(pages_[l_page]))[OffsetOf(index)];
+}
+
+template<typename T, uint64_t PageSize>
+const T& PagedArray<T, PageSize>::operator[](const uint64_t index) const
+{
+	return PageOfEntry(pages_[PageOf(index)])[OffsetOf(index)];
+}
+
+template<typename T, uint64_t PageSize>
+void PagedArray<T, PageSize>::Clear()
+{
+	for (uint64_t l_page = 0; l_page < page_count_; ++l_page)
+	{
+		if (pages_[l_page])
+		{
+			ReleasePage(PageOfEntry(pages_[l_page]));
+		}
+	}
+	if (pages_)
+	{
+		EASTLAllocatorType("Ecs").deallocate(pages_, page_count_ * sizeof(uintptr_t));
+	}
+	pages_		= nullptr;
+	page_count_ = 0;
+}
+
+template<typename T, uint64_t PageSize>
+template<typename StreamType>
+void PagedArray<T, PageSize>::Save(StreamType& stream, const uint64_t count, RESULT_PARAM_IMPL) const
+{
+	static_assert(eastl::is_trivially_copyable_v<T>, "Only trivially copyable elements are saved as raw pages.");
+	RESULT_ENSURE_LAST_NOLOG();
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&count, sizeof count, RESULT_ARG_PASS), StreamFailedToWrite);
+	for (uint64_t l_first = 0; l_first < count; l_first += PageSize)
+	{
+		const T* const l_page	 = Page(PageOf(l_first));
+		const uint8_t  l_present = l_page != nullptr;
+		RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&l_present, sizeof l_present, RESULT_ARG_PASS),
+									  StreamFailedToWrite);
+		if (l_page)
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(
+				stream.WriteGeneric(l_page, eastl::min(PageSize, count - l_first) * sizeof(T), RESULT_ARG_PASS),
+				StreamFailedToWrite);
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename T, uint64_t PageSize>
+template<typename StreamType>
+void PagedArray<T, PageSize>::Load(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	static_assert(eastl::is_trivially_copyable_v<T>, "Only trivially copyable elements are loaded as raw pages.");
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_count{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_count, sizeof l_count, RESULT_ARG_PASS), StreamFailedToRead);
+	for (uint64_t l_first = 0; l_first < l_count; l_first += PageSize)
+	{
+		uint8_t l_present{};
+		RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_present, sizeof l_present, RESULT_ARG_PASS),
+									  StreamFailedToRead);
+		if (l_present)
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(AssurePage(PageOf(l_first)),
+															 eastl::min(PageSize, l_count - l_first) * sizeof(T),
+															 RESULT_ARG_PASS),
+										  StreamFailedToRead);
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename T, uint64_t PageSize>
+template<typename StreamType>
+void PagedArray<T, PageSize>::SaveDelta(const PagedArray& baseline, StreamType& stream, const uint64_t count,
+										RESULT_PARAM_IMPL) const
+{
+	static_assert(eastl::is_trivially_copyable_v<T>, "Only trivially copyable elements are compared as raw pages.");
+	RESULT_ENSURE_LAST_NOLOG();
+
+	// Pages are only released all at once, so a missing baseline page means the array was cleared since
+	uint8_t l_full = false;
+	for (uint64_t l_page = 0; l_page < baseline.page_count_ && !l_full; ++l_page)
+	{
+		l_full = baseline.pages_[l_page] && !Page(l_page);
+	}
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&l_full, sizeof l_full, RESULT_ARG_PASS), StreamFailedToWrite);
+	if (l_full)
+	{
+		RESULT_ENSURE_CALL_NOLOG(Save(stream, count, RESULT_ARG_PASS));
+		RESULT_OK();
+		return;
+	}
+
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&count, sizeof count, RESULT_ARG_PASS), StreamFailedToWrite);
+	for (uint64_t l_first = 0; l_first < count; l_first += PageSize)
+	{
+		const auto	   l_page  = reinterpret_cast<const uint8_t*>(Page(PageOf(l_first)));
+		const auto	   l_base  = reinterpret_cast<const uint8_t*>(baseline.Page(PageOf(l_first)));
+		const uint64_t l_bytes = eastl::min(PageSize, count - l_first) * sizeof(T);
+
+		uint8_t	 l_type = !l_page || l_page == l_base ? eDeltaSkip : !l_base ? eDeltaPage : eDeltaBlocks;
+		uint64_t l_mask[DELTA_MASK_WORDS]{};
+		if (l_type == eDeltaBlocks)
+		{
+			bool l_any = false;
+			for (uint64_t l_offset = 0; l_offset < l_bytes; l_offset += DELTA_BLOCK_SIZE)
+			{
+				if (memcmp(l_page + l_offset, l_base + l_offset, eastl::min(DELTA_BLOCK_SIZE, l_bytes - l_offset)))
+				{
+					const uint64_t l_block = l_offset / DELTA_BLOCK_SIZE;
+					l_mask[l_block / 64] |= uint64_t{1} << (l_block % 64);
+					l_any = true;
+				}
+			}
+			l_type = l_any ? eDeltaBlocks : eDeltaSkip;
+		}
+
+		RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&l_type, sizeof l_type, RESULT_ARG_PASS),
+									  StreamFailedToWrite);
+		if (l_type == eDeltaPage)
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_page, l_bytes, RESULT_ARG_PASS), StreamFailedToWrite);
+		}
+		else if (l_type == eDeltaBlocks)
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_mask, sizeof l_mask, RESULT_ARG_PASS),
+										  StreamFailedToWrite);
+			for (uint64_t l_offset = 0; l_offset < l_bytes; l_offset += DELTA_BLOCK_SIZE)
+			{
+				const uint64_t l_block = l_offset / DELTA_BLOCK_SIZE;
+				if (l_mask[l_block / 64] & (uint64_t{1} << (l_block % 64)))
+				{
+					RESULT_CONDITION_ENSURE_NOLOG(
+						stream.WriteGeneric(l_page + l_offset, eastl::min(DELTA_BLOCK_SIZE, l_bytes - l_offset),
+											RESULT_ARG_PASS),
+						StreamFailedToWrite);
+				}
+			}
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename T, uint64_t PageSize>
+template<typename StreamType>
+void PagedArray<T, PageSize>::LoadDelta(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	static_assert(eastl::is_trivially_copyable_v<T>, "Only trivially copyable elements are compared as raw pages.");
+	RESULT_ENSURE_LAST_NOLOG();
+	uint8_t l_full{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_full, sizeof l_full, RESULT_ARG_PASS), StreamFailedToRead);
+	if (l_full)
+	{
+		Clear();
+		RESULT_ENSURE_CALL_NOLOG(Load(stream, RESULT_ARG_PASS));
+		RESULT_OK();
+		return;
+	}
+
+	uint64_t l_count{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_count, sizeof l_count, RESULT_ARG_PASS), StreamFailedToRead);
+	for (uint64_t l_first = 0; l_first < l_count; l_first += PageSize)
+	{
+		const uint64_t l_bytes = eastl::min(PageSize, l_count - l_first) * sizeof(T);
+		uint8_t		   l_type{};
+		RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_type, sizeof l_type, RESULT_ARG_PASS), StreamFailedToRead);
+		if (l_type == eDeltaPage)
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(AssurePage(PageOf(l_first)), l_bytes, RESULT_ARG_PASS),
+										  StreamFailedToRead);
+		}
+		else if (l_type == eDeltaBlocks)
+		{
+			const auto l_page = reinterpret_cast<uint8_t*>(Page(PageOf(l_first)));
+			RESULT_CONDITION_ENSURE_NOLOG(l_page, EcsInvalidSnapshot);
+			uint64_t l_mask[DELTA_MASK_WORDS]{};
+			RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_mask, sizeof l_mask, RESULT_ARG_PASS),
+										  StreamFailedToRead);
+			for (uint64_t l_offset = 0; l_offset < l_bytes; l_offset += DELTA_BLOCK_SIZE)
+			{
+				const uint64_t l_block = l_offset / DELTA_BLOCK_SIZE;
+				if (l_mask[l_block / 64] & (uint64_t{1} << (l_block % 64)))
+				{
+					RESULT_CONDITION_ENSURE_NOLOG(
+						stream.ReadGeneric(l_page + l_offset, eastl::min(DELTA_BLOCK_SIZE, l_bytes - l_offset),
+										   RESULT_ARG_PASS),
+						StreamFailedToRead);
+				}
+			}
+		}
+		else
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(l_type == eDeltaSkip, EcsInvalidSnapshot);
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename T, uint64_t PageSize>
+PagedArray<T, PageSize> PagedArray<T, PageSize>::Share()
+{
+	static_assert(eastl::is_trivially_copyable_v<T>, "Only trivially copyable elements are copied on write.");
+	PagedArray l_shared;
+	if (page_count_)
+	{
+		l_shared.GrowDirectory(page_count_);
+	}
+	for (uint64_t l_page = 0; l_page < page_count_; ++l_page)
+	{
+		if (pages_[l_page])
+		{
+			HeaderOf(PageOfEntry(pages_[l_page]))->references.fetch_add(1, eastl::memory_order_relaxed);
+			pages_[l_page] |= SHARED_TAG;
+			l_shared.pages_[l_page] = pages_[l_page];
+		}
+	}
+	return l_shared;
+}
+
+template<typename T, uint64_t PageSize>
+void PagedArray<T, PageSize>::UnshareAll()
+{
+	for (uint64_t l_page = 0; l_page < page_count_; ++l_page)
+	{
+		if (pages_[l_page] & SHARED_TAG)
+		{
+			Unshare(l_page);
+		}
+	}
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::PageOfEntry(const uintptr_t entry)
+{
+	return reinterpret_cast<T*>(entry & ~SHARED_TAG);
+}
+
+template<typename T, uint64_t PageSize>
+typename PagedArray<T, PageSize>::PageHeader* PagedArray<T, PageSize>::HeaderOf(const T* page)
+{
+	return reinterpret_cast<PageHeader*>(reinterpret_cast<uintptr_t>(page) - HEADER_SIZE);
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::AllocatePage()
+{
+	static_assert(sizeof(PageHeader) <= HEADER_SIZE, "Page header does not fit.");
+	auto l_memory = static_cast<uint8_t*>(
+		EASTLAllocatorType("Ecs").allocate(HEADER_SIZE + PageSize * sizeof(T), PAGE_ALIGNMENT, 0));
+	new (l_memory) PageHeader{1};
+	return reinterpret_cast<T*>(l_memory + HEADER_SIZE);
+}
+
+template<typename T, uint64_t PageSize>
+void PagedArray<T, PageSize>::ReleasePage(T* page)
+{
+	PageHeader* l_header = HeaderOf(page);
+	if (l_header->references.fetch_sub(1, eastl::memory_order_acq_rel) == 1)
+	{
+		l_header->~PageHeader();
+		EASTLAllocatorType("Ecs").deallocate(l_header, HEADER_SIZE + PageSize * sizeof(T));
+	}
+}
+
+template<typename T, uint64_t PageSize>
+T* PagedArray<T, PageSize>::Unshare(const uint64_t page)
+{
+	// The other owner may have released the page already, then it is kept as is
+	T* l_page = PageOfEntry(pages_[page]);
+	if (HeaderOf(l_page)->references.load(eastl::memory_order_acquire) != 1)
+	{
+		T* l_copy = AllocatePage();
+		memcpy(static_cast<void*>(l_copy), l_page, PageSize * sizeof(T));
+		ReleasePage(l_page);
+		l_page = l_copy;
+	}
+	pages_[page] = reinterpret_cast<uintptr_t>(l_page);
+	return l_page;
+}
+
+template<typename T, uint64_t PageSize>
+void PagedArray<T, PageSize>::GrowDirectory(const uint64_t page_count)
+{
+	// Only the directory is reallocated, the pages keep their address
+	auto l_pages = static_cast<uintptr_t*>(EASTLAllocatorType("Ecs").allocate(page_count * sizeof(uintptr_t)));
+	eastl::fill_n(l_pages, page_count, uintptr_t{0});
+	if (pages_)
+	{
+		eastl::copy_n(pages_, page_count_, l_pages);
+		EASTLAllocatorType("Ecs").deallocate(pages_, page_count_ * sizeof(uintptr_t));
+	}
+	pages_		= l_pages;
+	page_count_ = page_count;
+}
+
+} // namespace Ecs
+
+#endif
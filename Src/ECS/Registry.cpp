@@ -1,2 +1,190 @@
-
 #include "ECS/Registry.h"
+
+#if CPU_X86
+#include <immintrin.h>
+#endif
+
+#if CPU_X86 && defined(__AVX2__)
+#define ECS_FILTER_AVX2 1
+#else
+#define ECS_FILTER_AVX2 0
+#endif
+
+namespace Ecs
+{
+
+namespace Detail
+{
+
+/**
+ * @brief Scalar test of one signature.
+ */
+static bool MatchSignature(const uint64_t* signature, const uint64_t words, const uint64_t* required,
+						   const uint64_t* excluded, const uint64_t* optional)
+{
+	uint64_t l_miss = 0;
+	uint64_t l_hit	= 0;
+	for (uint64_t l_word = 0; l_word < words; ++l_word)
+	{
+		l_miss |= ((signature[l_word] & required[l_word]) ^ required[l_word]) | (signature[l_word] & excluded[l_word]);
+		l_hit |= signature[l_word] & optional[l_word];
+	}
+	return l_miss == 0 && l_hit != 0;
+}
+
+#if CPU_X86
+
+/**
+ * @brief Write the ids of the lanes set in the match mask.
+ */
+static uint64_t EmitLanes(const uint32_t mask, const entity_id_t first, entity_id_t* ids)
+{
+	uint64_t l_count = 0;
+	for (uint32_t l_lane = 0; (mask >> l_lane) != 0; ++l_lane)
+	{
+		if ((mask >> l_lane) & 1)
+		{
+			ids[l_count++] = first + l_lane;
+		}
+	}
+	return l_count;
+}
+
+/**
+ * @brief Test one signature of several words, two words per register and the odd word in scalar code.
+ */
+static bool MatchWideSignature(const uint64_t* signature, const uint64_t words, const uint64_t* required,
+							   const uint64_t* excluded, const uint64_t* optional)
+{
+	__m128i	 l_miss = _mm_setzero_si128();
+	__m128i	 l_hit	= _mm_setzero_si128();
+	uint64_t l_word = 0;
+	for (; l_word + 2 <= words; l_word += 2)
+	{
+		const __m128i l_signature = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signature + l_word));
+		const __m128i l_required  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(required + l_word));
+		const __m128i l_excluded  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(excluded + l_word));
+		const __m128i l_optional  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(optional + l_word));
+		l_miss = _mm_or_si128(l_miss, _mm_xor_si128(_mm_and_si128(l_signature, l_required), l_required));
+		l_miss = _mm_or_si128(l_miss, _mm_and_si128(l_signature, l_excluded));
+		l_hit  = _mm_or_si128(l_hit, _mm_and_si128(l_signature, l_optional));
+	}
+	const bool l_clean = _mm_movemask_epi8(_mm_cmpeq_epi8(l_miss, _mm_setzero_si128())) == 0xFFFF;
+	const bool l_any   = _mm_movemask_epi8(_mm_cmpeq_epi8(l_hit, _mm_setzero_si128())) != 0xFFFF;
+	if (l_word == words)
+	{
+		return l_clean && l_any;
+	}
+	const uint64_t l_last = signature[l_word];
+	return l_clean && ((l_last & required[l_word]) ^ required[l_word]) == 0 && (l_last & excluded[l_word]) == 0 &&
+		   (l_any || (l_last & optional[l_word]) != 0);
+}
+
+#endif
+
+#if ECS_FILTER_AVX2
+
+/**
+ * @brief Test signatures of one word, four per register.
+ */
+static uint64_t FilterNarrowSignatures(const uint64_t* signatures, const uint64_t count, const uint64_t required,
+									   const uint64_t excluded, const uint64_t optional, const entity_id_t first,
+									   entity_id_t* ids, uint64_t& index)
+{
+	const __m256i l_required = _mm256_set1_epi64x(static_cast<int64_t>(required));
+	const __m256i l_excluded = _mm256_set1_epi64x(static_cast<int64_t>(excluded));
+	const __m256i l_optional = _mm256_set1_epi64x(static_cast<int64_t>(optional));
+	const __m256i l_zero	 = _mm256_setzero_si256();
+	uint64_t	  l_count	 = 0;
+	for (; index + 4 <= count; index += 4)
+	{
+		const __m256i l_signature = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(signatures + index));
+		const __m256i l_miss	  = _mm256_or_si256(_mm256_xor_si256(_mm256_and_si256(l_signature, l_required), l_required),
+													_mm256_and_si256(l_signature, l_excluded));
+		const __m256i l_clean	  = _mm256_cmpeq_epi64(l_miss, l_zero);
+		const __m256i l_none	  = _mm256_cmpeq_epi64(_mm256_and_si256(l_signature, l_optional), l_zero);
+		const int	  l_mask	  = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_andnot_si256(l_none, l_clean)));
+		if (l_mask != 0)
+		{
+			l_count += EmitLanes(static_cast<uint32_t>(l_mask), first + index, ids + l_count);
+		}
+	}
+	return l_count;
+}
+
+#elif CPU_X86
+
+/**
+ * @brief Lanes of 64 bits equal to zero, SSE2 has no 64-bit compare.
+ */
+static __m128i CompareZero64(const __m128i value)
+{
+	const __m128i l_zero = _mm_cmpeq_epi32(value, _mm_setzero_si128());
+	return _mm_and_si128(l_zero, _mm_shuffle_epi32(l_zero, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/**
+ * @brief Test signatures of one word, two per register.
+ */
+static uint64_t FilterNarrowSignatures(const uint64_t* signatures, const uint64_t count, const uint64_t required,
+									   const uint64_t excluded, const uint64_t optional, const entity_id_t first,
+									   entity_id_t* ids, uint64_t& index)
+{
+	const __m128i l_required = _mm_set1_epi64x(static_cast<int64_t>(required));
+	const __m128i l_excluded = _mm_set1_epi64x(static_cast<int64_t>(excluded));
+	const __m128i l_optional = _mm_set1_epi64x(static_cast<int64_t>(optional));
+	uint64_t	  l_count	 = 0;
+	for (; index + 2 <= count; index += 2)
+	{
+		const __m128i l_signature = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signatures + index));
+		const __m128i l_miss	  = _mm_or_si128(_mm_xor_si128(_mm_and_si128(l_signature, l_required), l_required),
+												 _mm_and_si128(l_signature, l_excluded));
+		const __m128i l_none	  = CompareZero64(_mm_and_si128(l_signature, l_optional));
+		const int	  l_mask	  = _mm_movemask_pd(_mm_castsi128_pd(_mm_andnot_si128(l_none, CompareZero64(l_miss))));
+		if (l_mask != 0)
+		{
+			l_count += EmitLanes(static_cast<uint32_t>(l_mask), first + index, ids + l_count);
+		}
+	}
+	return l_count;
+}
+
+#endif
+
+uint64_t FilterSignatures(const uint64_t* signatures, const uint64_t words, const uint64_t count,
+						  const uint64_t* required, const uint64_t* excluded, const uint64_t* optional,
+						  const entity_id_t first, entity_id_t* ids)
+{
+	uint64_t l_count = 0;
+	uint64_t l_index = 0;
+#if CPU_X86
+	if (words == 1)
+	{
+		l_count = FilterNarrowSignatures(signatures, count, *required, *excluded, *optional, first, ids, l_index);
+	}
+	else
+	{
+		for (; l_index < count; ++l_index)
+		{
+			if (MatchWideSignature(signatures + l_index * words, words, required, excluded, optional))
+			{
+				ids[l_count++] = first + l_index;
+			}
+		}
+	}
+#endif
+
+	// Tail that does not fill a register, or every signature without SIMD
+	for (; l_index < count; ++l_index)
+	{
+		if (MatchSignature(signatures + l_index * words, words, required, excluded, optional))
+		{
+			ids[l_count++] = first + l_index;
+		}
+	}
+	return l_count;
+}
+
+} // namespace Detail
+
+} // namespace Ecs
@@ -13,7 +13,10 @@
 #include "Core/Common.h"
 #include "Core/Allocator.h"
 #include "ECS/Component.h"
+#include "ECS/PagedArray.h"
 #include "Core/Ptr.h"
+#include "Core/JobPool.h"
+#include "Core/Stream.h"
 
 #include <EASTL/hash_map.h>
 #include <EASTL/hash_set.h>
@@ -22,6 +25,9 @@
 #include <EASTL/bitvector.h>
 #include <EASTL/span.h>
 #include <EASTL/tuple.h>
+#include <EASTL/numeric.h>
+#include <EASTL/atomic.h>
+#include <EASTL/array.h>
 
 LOG_DEFINE(Ecs)
 
@@ -29,6 +35,18 @@ LOG_DEFINE(Ecs)
 #define ENTITY_ID_TYPE uint64_t
 #endif
 
+#ifndef ECS_TICK_TYPE
+#define ECS_TICK_TYPE uint32_t
+#endif
+
+#ifndef ECS_GENERATION_TYPE
+#define ECS_GENERATION_TYPE uint32_t
+#endif
+
+#ifndef ECS_PARALLEL_GRAIN
+#define ECS_PARALLEL_GRAIN 1024ull
+#endif
+
 #if _MSC_VER
 #pragma warning(disable : 4324)
 #endif
@@ -36,7 +54,148 @@ LOG_DEFINE(Ecs)
 namespace Ecs
 {
 
-using entity_id_t = ENTITY_ID_TYPE;
+using entity_id_t	 = ENTITY_ID_TYPE;
+using tick_t		 = ECS_TICK_TYPE;
+using generation_t = ECS_GENERATION_TYPE;
+
+/**
+ * @brief Entity id with the generation of its slot, see @ref Registry::Handle.
+ *
+ * Ids are reused after destruction, the generation tells the entity apart from later ones that take its id.
+ *
+ */
+struct EntityHandle
+{
+	entity_id_t	 id;
+	generation_t generation;
+};
+
+/**
+ * @brief Occupancy and memory of a component array, see @ref Registry::Stats.
+ *
+ * Free slots are the holes that iteration still walks: the free list of sparse storage, the entity ids below the
+ * highest one without the component for SoA storage and the unused values for shared storage.
+ *
+ */
+struct ComponentStats
+{
+	bool	  constructed;
+	uint64_t  capacity;
+	uint64_t  size;
+	uint64_t  free_slots;
+	uint64_t  data_bytes;
+	uint64_t  index_bytes;
+	uint64_t  tick_bytes;
+	float32_t fragmentation;
+};
+
+template<typename TypeList>
+class CommandBuffer;
+
+/**
+ * @brief Parent link of an entity, changed only by @ref Registry::SetParent.
+ *
+ * The components are stored in depth-first order: a parent comes before its children and every subtree is
+ * contiguous, so the hierarchy is walked by one linear pass (@ref Registry::EachHierarchy).
+ * Adding the component with a parent attaches it like @ref Registry::SetParent. Removing it, or destroying the
+ * entity, attaches its children to its parent.
+ *
+ */
+struct HierarchyComponent
+{
+	ECS_COMPONENT_BODY(HierarchyComponent);
+	entity_id_t parent{eastl::numeric_limits<entity_id_t>::max()};
+	uint64_t	depth{};
+};
+
+template<>
+struct ComponentStorageOf<HierarchyComponent>
+{
+	static constexpr ComponentStorage::Type VALUE = ComponentStorage::eDense;
+};
+
+namespace Detail
+{
+
+/**
+ * @brief Stable LSD radix sort, 8 bits per pass. Passes where every key has the same digit are skipped.
+ *
+ * @param keys Keys to sort, they are sorted in place.
+ * @return Permutation, the element index is the original index of the index-th key.
+ *
+ */
+template<typename Key>
+eastl::vector<uint32_t> RadixSort(eastl::vector<Key>& keys)
+{
+	static_assert(eastl::is_unsigned_v<Key>, "Radix sort keys must be unsigned integers.");
+	constexpr uint64_t l_passes = sizeof(Key);
+	const uint64_t	   l_count	= keys.size();
+	ASSERT(l_count <= eastl::numeric_limits<uint32_t>::max());
+
+	eastl::vector<uint32_t> l_order(l_count);
+	eastl::iota(l_order.begin(), l_order.end(), 0u);
+	if (l_count < 2)
+	{
+		return l_order;
+	}
+
+	// Histograms of every digit in one read of the keys
+	eastl::vector<uint64_t> l_offsets(l_passes * 256, 0);
+	for (const Key l_key : keys)
+	{
+		for (uint64_t l_pass = 0; l_pass < l_passes; ++l_pass)
+		{
+			++l_offsets[l_pass * 256 + ((l_key >> (l_pass * 8)) & 0xFF)];
+		}
+	}
+
+	eastl::vector<Key>		l_keys(l_count);
+	eastl::vector<uint32_t> l_next(l_count);
+	for (uint64_t l_pass = 0; l_pass < l_passes; ++l_pass)
+	{
+		uint64_t* const l_offset = l_offsets.data() + l_pass * 256;
+		const uint64_t	l_shift	 = l_pass * 8;
+		if (l_offset[(keys[0] >> l_shift) & 0xFF] == l_count)
+		{
+			continue;
+		}
+		for (uint64_t l_digit = 0, l_sum = 0; l_digit < 256; ++l_digit)
+		{
+			l_sum += eastl::exchange(l_offset[l_digit], l_sum);
+		}
+		for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+		{
+			const uint64_t l_target = l_offset[(keys[l_index] >> l_shift) & 0xFF]++;
+			l_keys[l_target]		= keys[l_index];
+			l_next[l_target]		= l_order[l_index];
+		}
+		keys.swap(l_keys);
+		l_order.swap(l_next);
+	}
+	return l_order;
+}
+
+/**
+ * @brief Write the ids of the signatures that match the masks, with AVX2 when the build enables it, otherwise SSE2.
+ *
+ * A signature matches when it has every bit of required, no bit of excluded and at least one bit of optional.
+ * Signatures are read as arrays of 64-bit words, the masks must have the same layout.
+ *
+ * @param signatures First signature, count * words words.
+ * @param words Words of each signature.
+ * @param count Signatures to test.
+ * @param required Required mask.
+ * @param excluded Excluded mask.
+ * @param optional Optional mask.
+ * @param first Entity id of the first signature.
+ * @param ids Output, it must have room for every match.
+ * @return Count of ids written.
+ *
+ */
+uint64_t FilterSignatures(const uint64_t* signatures, uint64_t words, uint64_t count, const uint64_t* required,
+						  const uint64_t* excluded, const uint64_t* optional, entity_id_t first, entity_id_t* ids);
+
+} // namespace Detail
 
 /**
  * @brief Registry class.
@@ -49,13 +208,30 @@ using entity_id_t = ENTITY_ID_TYPE;
  *   Ex: signature of TypeList<Component1, Component2> is the same of TypeList<Component2, Component1>,
  *	 that will be accessed by the same indices because it is a tuple that will be used. But the user can't know that,
  *	 the api is supported by use of typename.
- * 3. Contiguous in memory.
- * 4. Fixed length of entities and components memory. It cannot grow.
+ * 3. Contiguous in memory inside fixed size pages (@ref ECS_PAGE_SIZE).
+ * 4. Grows on demand. Pages are never moved, so pointers to entities and components stay valid.
+ * 5. Empty components are tags (@ref IsTagComponent), stored only as a signature bit.
+ * 6. Opt-in SoA storage of glm::vec3 components (@ref ComponentStorage::eSoa), read in bulk by @ref Streams.
+ * 7. Change tracking, every component keeps the tick it was added and last changed (@ref Changed, @ref Added).
+ * 8. Structural changes can be recorded by worker threads in a @ref CommandBuffer and applied by @ref Playback.
+ * 9. Parent/child hierarchy stored in depth-first order (@ref HierarchyComponent, @ref SetParent).
+ * 10. Owning groups keep the entities that have every component of the group packed at the front of the arrays
+ *	(@ref Group, @ref EachGroup).
+ * 11. Opt-in shared storage of repeated values (@ref ComponentStorage::eShared), batched by value by
+ *	@ref EachShared.
+ * 12. Lock-free entity creation from jobs (@ref CreateConcurrent), generations tell reused ids apart (@ref Handle).
+ * 13. Cached queries, entity lists kept up to date by every signature change (@ref Query, @ref EachQuery).
+ * 14. Bulk SIMD filter of the signatures with required, excluded and optional masks (@ref Filter).
+ * 15. Occupancy and memory report of every array, cheap enough to sample every frame (@ref Stats).
+ * 16. Incremental compaction of sparse storage with a budget per call (@ref Compact).
+ * 17. Bulk instantiation of a prefab entity, one copy per array instead of one per entity (@ref Instantiate).
  *
  * Data:
- * 1. Array of entity ids.
- * 2. Array of signatures.
+ * 1. Paged stack of entity ids, with an atomic cursor. The live ids are below the cursor, the free ids above it.
+ * 2. Paged array of signatures.
  * 3. Tuple of array of components.
+ * 4. Paged array of generations by entity id.
+ * 5. Paged array of the position of every id in the stack, an id is live when it is below the cursor.
  *
  */
 template<typename TypeList>
@@ -66,6 +242,22 @@ public:
 	using signature_t							   = eastl::bitset<components_t::SIZE>;
 	static constexpr entity_id_t INVALID_ENTITY_ID = eastl::numeric_limits<uint64_t>::max();
 
+	/**
+	 * @brief Occupancy and memory of the registry, see @ref Stats.
+	 *
+	 * Components are in type list order. Entity bytes are the id stack and the generations.
+	 *
+	 */
+	struct RegistryStats
+	{
+		eastl::array<ComponentStats, components_t::SIZE> components;
+		uint64_t										 entity_capacity;
+		uint64_t										 entity_size;
+		uint64_t										 entity_bytes;
+		uint64_t										 signature_bytes;
+		uint64_t										 total_bytes;
+	};
+
 private:
 	/**
 	 * @brief Component array class.
@@ -73,9 +265,12 @@ private:
 	 * This class is private to use internally in @ref Registry.
 	 *
 	 * Data:
-	 * 1. Array of components.
-	 * 2. Array of entity indices.
-	 * 3. Free list for removed components.
+	 * 1. Paged array of components.
+	 * 2. Paged array of 32-bit component indices by entity, a page is only allocated when an entity inside it is added.
+	 * 3. Paged array of entities by component index (reverse of 2).
+	 * 4. Free list for removed components (only sparse storage). It is doubly linked: the next hole is stored in the
+	 *	hole and the previous one in its added tick, so @ref Compact unlinks any hole.
+	 * 5. Paged arrays of added and changed ticks by component index.
 	 *
 	 * Behavior:
 	 * 1. @ref Add
@@ -83,6 +278,14 @@ private:
 	 * 3. @ref Get
 	 * 4. @ref Contains
 	 * 5. @ref Each
+	 * 6. @ref EachRange
+	 * 7. @ref AddMany
+	 * 8. @ref EachSince
+	 *
+	 * Storage is selected by @ref ComponentStorageOf:
+	 * 1. Sparse: removal punches a hole that is threaded onto the free list, iteration skips holes.
+	 * 2. Dense: removal moves the last component into the hole, iteration runs over exactly @ref Size elements.
+	 * Sparse storage is compacted on demand by @ref Compact.
 	 *
 	 * @tparam Component Target component type.
 	 *
@@ -90,36 +293,166 @@ private:
 	template<typename Component>
 	class ComponentArray final
 	{
-		static_assert(alignof(Component) >= sizeof(intptr_t),
+		static constexpr bool DENSE = ComponentStorageOf<Component>::VALUE == ComponentStorage::eDense;
+
+		static_assert(DENSE || IsTagComponent<Component>::VALUE || alignof(Component) >= sizeof(intptr_t),
 					  "Invalid min component size to be able to be wrapped by free list.");
+		static_assert(DENSE || sizeof(tick_t) >= sizeof(uint32_t),
+					  "Sparse storage keeps the previous free list link in the added tick.");
 
 		friend class Registry;
 
+		using component_t = Component;
+
 		struct CursorFreeList
 		{
-			CursorFreeList* next{};
+			uint64_t next{};
 		};
 
-		EXPLICIT ComponentArray(uint64_t capacity);
+		ComponentArray() = default;
 
 	private:
-		void Add(entity_id_t id, Component&& component, RESULT_PARAM_DEFINE);
+		void Add(entity_id_t id, Component&& component, tick_t tick, RESULT_PARAM_DEFINE);
 		void Remove(entity_id_t id, RESULT_PARAM_DEFINE);
-		void Each(void (*function)(Component&))
-		{
-			eastl::for_each(eindex_, eindex_end_, [&](uint64_t& e) {
-				if (e != INVALID_COMPONENT_ID)
-				{
-					function(data_[e]);
-				}
-			});
-		}
+
+		/**
+		 * @brief Add one component per entity, the entities must be unique.
+		 *
+		 * Trivially copyable components are copied with one memcpy per page into the slots after the cursor.
+		 *
+		 */
+		void AddMany(eastl::span<const entity_id_t> ids, eastl::span<Component> components, tick_t tick,
+					 RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Add a copy of the component of the source entity to every new entity.
+		 *
+		 * Filled like @ref AddMany, one fill per page into the slots after the cursor.
+		 *
+		 */
+		void AddCopies(eastl::span<const entity_id_t> ids, entity_id_t source, tick_t tick);
+
+		/**
+		 * @brief Iterate the components whose added (or changed) tick is newer than since.
+		 *
+		 * Only the tick arrays are scanned, components are touched just for matches.
+		 *
+		 */
+		template<bool Added, typename Function>
+		void EachSince(tick_t since, Function&& function);
+
+		template<typename Function>
+		void Each(Function&& function);
+
+		/**
+		 * @brief Iterate the used slots in [begin, end), holes of sparse storage are skipped.
+		 */
+		template<typename Function>
+		void EachRange(uint64_t begin, uint64_t end, Function&& function);
 
 		NODISCARD Component* Get(entity_id_t id);
+		NODISCARD tick_t*	 ChangedTick(entity_id_t id);
 		NODISCARD bool		 Contains(entity_id_t id) const;
+		NODISCARD uint64_t	 Size() const;
+		NODISCARD uint64_t	 Slots() const;
+
+		NODISCARD ComponentStats Stats() const;
+
+		/**
+		 * @brief Write the array to a stream.
+		 *
+		 * Trivially copyable components are written as raw pages, holes included, so the free list survives as is.
+		 * Other components are written one by one with Stream::Impl.
+		 *
+		 */
+		template<typename StreamType>
+		void Write(StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+		/**
+		 * @brief Read the array written by @ref Write, the array must be empty.
+		 */
+		template<typename StreamType>
+		void Read(StreamType& stream, RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Fill an empty array with a copy-on-write copy of this one (@ref PagedArray::Share).
+		 *
+		 * Components that are not trivially copyable are copied one by one.
+		 *
+		 */
+		void Freeze(ComponentArray& frozen);
+
+		/**
+		 * @brief Copy the pages still shared with a frozen array, before jobs use the array concurrently.
+		 */
+		void Unshare();
+
+		/**
+		 * @brief Write the difference against a baseline array (@ref PagedArray::SaveDelta), only for trivially
+		 * copyable components.
+		 */
+		template<typename StreamType>
+		void WriteDelta(const ComponentArray& baseline, StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+		template<typename StreamType>
+		void ReadDelta(StreamType& stream, RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Move the last components into the holes and cut the holes off the end, at most budget slots.
+		 *
+		 * Only for sparse storage. Components keep their entity and ticks, the component indices are updated.
+		 *
+		 * @return Holes left, 0 when the array is compact.
+		 *
+		 */
+		uint64_t Compact(uint64_t budget);
+
+	private:
+		uint64_t AcquireSlot();
+		void	 Bind(entity_id_t id, uint64_t index, tick_t tick);
+		void	 LinkFree(uint64_t index);
+		void	 UnlinkFree(uint64_t index);
+
+		/**
+		 * @brief Add one component per entity, built as construct(data, first, count) for the components
+		 * [first, first + count) of the range. Holes are filled one by one, the tail one call per page.
+		 */
+		template<typename Construct>
+		void AddRange(eastl::span<const entity_id_t> ids, tick_t tick, Construct&& construct);
+
+		/**
+		 * @brief Rotate the slots [first, last) so the slot middle becomes the first, like eastl::rotate.
+		 *
+		 * Only for dense storage. Components and ticks move with their entity, the component indices are updated.
+		 *
+		 */
+		void Rotate(uint64_t first, uint64_t middle, uint64_t last);
+		void Reverse(uint64_t first, uint64_t last);
+
+		/**
+		 * @brief Swap two slots, the component indices are updated. Only for dense storage.
+		 */
+		void Swap(uint64_t first, uint64_t second);
+
+		/**
+		 * @brief Reorder the slots, the slot index receives the slot order[index]. Only for dense storage.
+		 */
+		void Permute(const eastl::vector<uint32_t>& order);
 
 	public:
 		static constexpr uint64_t INVALID_COMPONENT_ID = eastl::numeric_limits<uint64_t>::max();
+		static constexpr uint64_t CACHE_LINE_ELEMENTS  = PagedArray<Component>::CACHE_LINE_ELEMENTS;
+
+		/**
+		 * @brief Sparse index type, it limits the component slots of an array to 2^32 - 1.
+		 */
+		using index_t						   = uint32_t;
+		static constexpr index_t INVALID_INDEX = eastl::numeric_limits<index_t>::max();
+
+		/**
+		 * @brief Previous link of the first hole of the free list.
+		 */
+		static constexpr tick_t FREE_LIST_HEAD = static_cast<tick_t>(INVALID_INDEX);
 
 		ComponentArray(ComponentArray&& other) NOEXCEPT		 = delete;
 		ComponentArray(const ComponentArray&)				 = delete;
@@ -128,31 +461,332 @@ private:
 		~ComponentArray();
 
 	private:
-		CursorFreeList* cursor_fl_{};
-		Component *		data_{}, *dcursor_{};
-		uint64_t *		eindex_{}, *eindex_end_{};
+		uint64_t				cursor_fl_{INVALID_COMPONENT_ID};
+		uint64_t				dcursor_{};
+		uint64_t				size_{};
+		PagedArray<Component>	data_;
+		PagedArray<entity_id_t> dentity_;
+		PagedArray<index_t>		eindex_;
+		PagedArray<tick_t>		added_;
+		PagedArray<tick_t>		changed_;
+	};
+
+	/**
+	 * @brief SoA component array class.
+	 *
+	 * This class is private to use internally in @ref Registry, it is selected by @ref ComponentStorage::eSoa.
+	 *
+	 * Data:
+	 * 1. Paged x, y and z streams of the glm::vec3 value, indexed by entity id. New pages are filled with the
+	 *	value of a default component.
+	 * 2. Paged bits of the entities that have the component.
+	 * 3. Paged added and changed ticks, indexed by entity id.
+	 *
+	 * Behavior is the same of @ref ComponentArray, except that there is no @ref Get. @ref EachRange hands out a
+	 * copy of the component, which is stored back after the call only when it changed.
+	 *
+	 * @tparam Component Target component type.
+	 *
+	 */
+	template<typename Component>
+	class SoaComponentArray final
+	{
+		static_assert(eastl::is_same_v<decltype(Component::value), glm::vec3>,
+					  "SoA storage needs a component with a glm::vec3 value.");
+
+		friend class Registry;
+
+		using component_t = Component;
+		using stream_t	  = PagedArray<float32_t>;
+		using bits_t	  = PagedArray<uint64_t, (stream_t::PAGE_SIZE + 63) / 64>;
+
+		SoaComponentArray() = default;
+
+	private:
+		void Add(entity_id_t id, Component&& component, tick_t tick, RESULT_PARAM_DEFINE);
+		void Remove(entity_id_t id, RESULT_PARAM_DEFINE);
+		void AddMany(eastl::span<const entity_id_t> ids, eastl::span<Component> components, tick_t tick,
+					 RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Add the value of the source entity to every new entity, it is loaded once.
+		 */
+		void AddCopies(eastl::span<const entity_id_t> ids, entity_id_t source, tick_t tick);
+
+		template<bool Added, typename Function>
+		void EachSince(tick_t since, Function&& function);
+
+		template<typename Function>
+		void Each(Function&& function);
+
+		/**
+		 * @brief Iterate the entities in [begin, end) that have the component, as function(entity_id_t, Component&).
+		 */
+		template<typename Function>
+		void EachRange(uint64_t begin, uint64_t end, Function&& function);
+
+		/**
+		 * @brief Iterate the entities in [begin, end) that have the component, as function(entity_id_t).
+		 */
+		template<typename Function>
+		void EachEntityRange(uint64_t begin, uint64_t end, Function&& function) const;
+
+		NODISCARD glm::vec3	 Load(entity_id_t id) const;
+		void				 Store(entity_id_t id, const glm::vec3& value);
+		NODISCARD SoaStreams Streams(uint64_t page);
+		NODISCARD tick_t*	 ChangedTick(entity_id_t id);
+		NODISCARD bool		 Contains(entity_id_t id) const;
+		NODISCARD uint64_t	 Size() const;
+		NODISCARD uint64_t	 Slots() const;
+
+		NODISCARD ComponentStats Stats() const;
+
+		/**
+		 * @brief Write the streams, bits and ticks to a stream as raw pages.
+		 */
+		template<typename StreamType>
+		void Write(StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+		template<typename StreamType>
+		void Read(StreamType& stream, RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Fill an empty array with a copy-on-write copy of this one (@ref PagedArray::Share).
+		 */
+		void Freeze(SoaComponentArray& frozen);
+
+		/**
+		 * @brief Copy the pages still shared with a frozen array, before jobs use the array concurrently.
+		 */
+		void Unshare();
+
+		template<typename StreamType>
+		void WriteDelta(const SoaComponentArray& baseline, StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+		template<typename StreamType>
+		void ReadDelta(StreamType& stream, RESULT_PARAM_DEFINE);
+
+	public:
+		static constexpr uint64_t CACHE_LINE_ELEMENTS = 64;
+
+		SoaComponentArray(SoaComponentArray&& other) NOEXCEPT		   = delete;
+		SoaComponentArray(const SoaComponentArray&)				   = delete;
+		SoaComponentArray& operator=(SoaComponentArray&&) NOEXCEPT = delete;
+		SoaComponentArray& operator=(const SoaComponentArray&)	   = delete;
+		~SoaComponentArray()									   = default;
+
+	private:
+		uint64_t size_{};
+		uint64_t slots_{};
+		stream_t x_;
+		stream_t y_;
+		stream_t z_;
+		bits_t	 bits_;
+
+		PagedArray<tick_t> added_;
+		PagedArray<tick_t> changed_;
+	};
+
+	/**
+	 * @brief Shared component array class.
+	 *
+	 * This class is private to use internally in @ref Registry, it is selected by @ref ComponentStorage::eShared.
+	 *
+	 * Data:
+	 * 1. Paged table of unique values with their reference counts. Free entries are threaded onto a free list.
+	 * 2. Hash map from value hash to the first value of its collision chain (@ref SharedComponentTraits).
+	 * 3. Dense paged arrays of value indices, entities and added and changed ticks by slot, with swap-and-pop
+	 *	removal.
+	 * 4. Paged array of 32-bit slot indices by entity.
+	 *
+	 * Behavior is the same of @ref SoaComponentArray: @ref EachRange hands out a copy of the value, which is stored
+	 * back only when it changed. Storing a value releases the old one and references an equal one, or adds it.
+	 * @ref EachValue batches the entities by value.
+	 *
+	 * @tparam Component Target component type.
+	 *
+	 */
+	template<typename Component>
+	class SharedComponentArray final
+	{
+		static_assert(eastl::is_trivially_copyable_v<Component>, "Shared storage needs a trivially copyable component.");
+
+		friend class Registry;
+
+		using component_t = Component;
+		using traits_t	  = SharedComponentTraits<Component>;
+
+	public:
+		using index_t						   = uint32_t;
+		static constexpr index_t INVALID_INDEX = eastl::numeric_limits<index_t>::max();
+
+	private:
+		struct Value
+		{
+			Component value;
+			index_t	  refs;
+			index_t	  next;
+		};
+
+		SharedComponentArray() = default;
+
+	private:
+		void Add(entity_id_t id, Component&& component, tick_t tick, RESULT_PARAM_DEFINE);
+		void Remove(entity_id_t id, RESULT_PARAM_DEFINE);
+		void AddMany(eastl::span<const entity_id_t> ids, eastl::span<Component> components, tick_t tick,
+					 RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Reference the value of the source entity from every new entity, without hashing it again.
+		 */
+		void AddCopies(eastl::span<const entity_id_t> ids, entity_id_t source, tick_t tick);
+
+		template<bool Added, typename Function>
+		void EachSince(tick_t since, Function&& function);
+
+		template<typename Function>
+		void Each(Function&& function);
+
+		/**
+		 * @brief Iterate the slots in [begin, end), as function(entity_id_t, Component&).
+		 */
+		template<typename Function>
+		void EachRange(uint64_t begin, uint64_t end, Function&& function);
+
+		/**
+		 * @brief Iterate the slots in [begin, end), as function(entity_id_t).
+		 */
+		template<typename Function>
+		void EachEntityRange(uint64_t begin, uint64_t end, Function&& function) const;
+
+		/**
+		 * @brief Iterate the values once, as function(const Component&, eastl::span<const entity_id_t>).
+		 *
+		 * The entities are bucketed by value index with one counting sort over the slots.
+		 *
+		 */
+		template<typename Function>
+		void EachValue(Function&& function) const;
+
+		NODISCARD const Component& Load(entity_id_t id) const;
+		void					   Store(entity_id_t id, const Component& component);
+		NODISCARD tick_t*		   ChangedTick(entity_id_t id);
+		NODISCARD bool			   Contains(entity_id_t id) const;
+		NODISCARD uint64_t		   Size() const;
+		NODISCARD uint64_t		   Slots() const;
+
+		/**
+		 * @brief Get the count of unique values.
+		 */
+		NODISCARD uint64_t ValueCount() const;
+
+		NODISCARD ComponentStats Stats() const;
+
+		/**
+		 * @brief Write the value table and the slot arrays to a stream as raw pages.
+		 */
+		template<typename StreamType>
+		void Write(StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+		/**
+		 * @brief Read the array written by @ref Write, the array must be empty. The hash map is rebuilt.
+		 */
+		template<typename StreamType>
+		void Read(StreamType& stream, RESULT_PARAM_DEFINE);
+
+		/**
+		 * @brief Fill an empty array with a copy-on-write copy of this one (@ref PagedArray::Share).
+		 */
+		void Freeze(SharedComponentArray& frozen);
+
+		/**
+		 * @brief Copy the pages still shared with a frozen array, before jobs use the array concurrently.
+		 */
+		void Unshare();
+
+		template<typename StreamType>
+		void WriteDelta(const SharedComponentArray& baseline, StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+		template<typename StreamType>
+		void ReadDelta(StreamType& stream, RESULT_PARAM_DEFINE);
+
+	private:
+		/**
+		 * @brief Reference the value equal to component, it is added when there is none.
+		 */
+		NODISCARD index_t Acquire(const Component& component);
+		void			  Release(index_t value);
+		void			  Assign(uint64_t slot, const Component& component);
+		void			  RebuildBuckets();
+
+		/**
+		 * @brief Append a slot of the entity referencing an acquired value.
+		 */
+		void Bind(entity_id_t id, index_t value, tick_t tick);
+
+	public:
+		static constexpr uint64_t CACHE_LINE_ELEMENTS = PagedArray<index_t>::CACHE_LINE_ELEMENTS;
+
+		SharedComponentArray(SharedComponentArray&& other) NOEXCEPT		 = delete;
+		SharedComponentArray(const SharedComponentArray&)				 = delete;
+		SharedComponentArray& operator=(SharedComponentArray&&) NOEXCEPT = delete;
+		SharedComponentArray& operator=(const SharedComponentArray&)	 = delete;
+		~SharedComponentArray()											 = default;
+
+	private:
+		uint64_t dcursor_{};
+		uint64_t vcursor_{};
+		uint64_t vsize_{};
+		uint64_t vfree_{INVALID_INDEX};
+
+		PagedArray<Value>				   values_;
+		eastl::hash_map<uint64_t, index_t> buckets_;
+		PagedArray<index_t>				   dvalue_;
+		PagedArray<entity_id_t>			   dentity_;
+		PagedArray<index_t>				   eindex_;
+		PagedArray<tick_t>				   added_;
+		PagedArray<tick_t>				   changed_;
 	};
 
 	template<typename Component>
 	class ComponentArrayElement
 	{
 	public:
-		using ComponentArrayType = ComponentArray<Component>;
+		using ComponentArrayType = eastl::conditional_t<
+			IsSoaComponent<Component>::VALUE, SoaComponentArray<Component>,
+			eastl::conditional_t<IsSharedComponent<Component>::VALUE, SharedComponentArray<Component>,
+								 ComponentArray<Component>>>;
 
 		bool constructed;
-		ALIGNAS(64) eastl::aligned_storage_t<sizeof ComponentArrayType> memory;
+		ALIGNAS(64) eastl::aligned_storage_t<sizeof(ComponentArrayType)> memory;
 
 	public:
 		ComponentArrayElement();
 
 	public:
-		void				ConstructIfAllowed(uint64_t capacity);
-		void				DestroyIfAllowed();
-		ComponentArrayType* Get();
+		void					  ConstructIfAllowed();
+		void					  DestroyIfAllowed();
+		ComponentArrayType*		  Get();
+		const ComponentArrayType* Get() const;
 	};
 
 	using component_map_tuple_t = typename TypeTraits::TlToTupleTransfer<ComponentArrayElement, components_t>::type_t;
 
+	template<typename Component>
+	using component_array_t = typename ComponentArrayElement<Component>::ComponentArrayType;
+
+	/**
+	 * @brief Copy of a SoA or shared component handed out by the views, other components need no slot.
+	 */
+	template<typename Component>
+	struct ViewNoSlot
+	{
+	};
+
+	template<typename Component>
+	using view_slot_t = eastl::conditional_t<IsSoaComponent<Component>::VALUE || IsSharedComponent<Component>::VALUE,
+											 Component, ViewNoSlot<Component>>;
+
 	template<typename Component>
 	static constexpr uint64_t GetComponentId();
 
@@ -168,12 +802,42 @@ private:
 	template<uint64_t Index>
 	void DestroyComponentsMap();
 
+	template<uint64_t Index>
+	void RemoveComponentsMap(entity_id_t id);
+
+	template<uint64_t Index, typename StreamType>
+	void SaveComponentsMap(StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+	template<uint64_t Index, typename StreamType>
+	void LoadComponentsMap(StreamType& stream, RESULT_PARAM_DEFINE);
+
+	template<uint64_t Index>
+	void FreezeComponentsMap(Registry& frozen);
+
+	template<uint64_t Index, typename StreamType>
+	void SaveDeltaComponentsMap(const Registry& baseline, StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+	template<uint64_t Index, typename StreamType>
+	void LoadDeltaComponentsMap(StreamType& stream, RESULT_PARAM_DEFINE);
+
+	template<uint64_t Index>
+	void StatsComponentsMap(RegistryStats& stats) const;
+
+	template<uint64_t Index>
+	void UnshareComponentsMap(const signature_t& mask);
+
+	template<uint64_t Index>
+	NODISCARD bool CopyableComponentsMap(entity_id_t id);
+
+	template<uint64_t Index>
+	void InstantiateComponentsMap(entity_id_t prefab, eastl::span<const entity_id_t> ids);
+
 	template<typename Component>
 	class ComponentPtr final
 	{
 		friend class Registry;
 
-		ComponentPtr(Registry* registry, Ptr<Component> component);
+		ComponentPtr(Registry* registry, Ptr<Component> component, tick_t* changed = nullptr);
 
 	public:
 		using underlyng_t = Component;
@@ -185,15 +849,22 @@ private:
 		~ComponentPtr();
 
 	public:
+		/**
+		 * @brief Mutable access, it stamps the component as changed in the current tick.
+		 */
 		auto&	 operator->();
 		auto&	 operator->() const;
 		EXPLICIT operator Component*();
 		EXPLICIT operator Component*() const;
 		EXPLICIT operator bool() const;
 
+	private:
+		void Touch();
+
 	private:
 		Registry*	   registry_;
 		Ptr<Component> component_;
+		tick_t*		   changed_;
 	};
 
 public:
@@ -210,493 +881,4154 @@ public:
 
 	void Destroy(entity_id_t id, RESULT_PARAM_DEFINE);
 
-public:
-	template<typename... Components>
-	void Enable(entity_id_t id, RESULT_PARAM_DEFINE);
+	/**
+	 * @brief Create an entity from any thread, lock-free.
+	 *
+	 * The id is taken from the free stack with a compare and swap of the cursor. Calls can run concurrently with
+	 * each other and with read-only use of the registry, not with other structural changes: components are added
+	 * later, like by a @ref CommandBuffer. The capacity never grows here, reserve it before (@ref Reserve).
+	 *
+	 * @return Id of the new entity, INVALID_ENTITY_ID with EcsNoEntityAvailable when the capacity is used up.
+	 *
+	 */
+	entity_id_t CreateConcurrent(RESULT_PARAM_DEFINE);
 
-	template<typename... Components>
-	void Disable(entity_id_t id, RESULT_PARAM_DEFINE);
+	/**
+	 * @brief Get the handle of a live entity, the generation of its slot grows every time the entity is destroyed.
+	 * Ids that are not live fail with EcsInvalidEntityId.
+	 */
+	NODISCARD EntityHandle Handle(entity_id_t id, RESULT_PARAM_DEFINE) const;
 
-	template<typename Component>
-	NODISCARD bool IsEnabled(entity_id_t id, RESULT_PARAM_DEFINE) const;
+	/**
+	 * @brief Tell whether the entity of the handle is live and was not destroyed since the handle was taken.
+	 */
+	NODISCARD bool IsAlive(const EntityHandle& handle, RESULT_PARAM_DEFINE) const;
 
-public:
-	template<typename Component>
-	void Add(entity_id_t id, Component&& component, RESULT_PARAM_DEFINE);
+	/**
+	 * @brief Create count entities at once.
+	 *
+	 * @param count Entities to create.
+	 * @param ids Output of the created ids, must hold at least count elements.
+	 *
+	 */
+	void CreateMany(uint64_t count, eastl::span<entity_id_t> ids, RESULT_PARAM_DEFINE);
 
-	template<typename Component>
-	void Remove(entity_id_t id, RESULT_PARAM_DEFINE);
+	/**
+	 * @brief Destroy every entity of the span, the ids are validated before any is destroyed.
+	 *
+	 * Ids that are not live or appear more than once fail with EcsInvalidEntityId.
+	 *
+	 */
+	void DestroyMany(eastl::span<const entity_id_t> ids, RESULT_PARAM_DEFINE);
 
-	template<typename Component>
-	ComponentPtr<Component> Get(entity_id_t id, RESULT_PARAM_DEFINE);
+	/**
+	 * @brief Create count entities as copies of the prefab entity.
+	 *
+	 * The new entities get the signature of the prefab, so disabled components stay disabled, and a copy of each
+	 * of its components. Every array is filled once for all the entities, sparse and dense storage with one fill
+	 * per page. The parent of the prefab is kept, its children are not copied.
+	 *
+	 * @param prefab Source entity, it is not changed.
+	 * @param count Entities to create.
+	 * @param ids Output of the created ids, must hold at least count elements.
+	 *
+	 */
+	void Instantiate(entity_id_t prefab, uint64_t count, eastl::span<entity_id_t> ids, RESULT_PARAM_DEFINE);
 
-	template<typename Component>
-	void Each(void (*function)(Component&), RESULT_PARAM_DEFINE);
+	/**
+	 * @brief Apply the commands recorded by the buffers (@ref CommandBuffer), defined in ECS/CommandBuffer.h.
+	 *
+	 * Must be called at a sync point, when no system uses the registry. The order is deterministic: commands are
+	 * ordered by sort key, then by buffer order in the span, then by recording order. Entities created by the
+	 * buffers are created before any other command. The buffers are cleared, even when a command fails.
+	 *
+	 */
+	void Playback(eastl::span<CommandBuffer<TypeList>* const> buffers, RESULT_PARAM_DEFINE);
+	void Playback(CommandBuffer<TypeList>& buffer, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Write a binary snapshot of the registry: entity slots, signatures, ticks and every constructed
+	 * component array.
+	 *
+	 * Trivially copyable data is written with one block per page, other components with Stream::Impl.
+	 *
+	 * @param stream Target stream (see Core/Stream.h).
+	 *
+	 */
+	template<typename StreamType>
+	void Save(StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief Replace the registry by a snapshot written with @ref Save.
+	 *
+	 * The snapshot must come from a registry of the same type list. On failure the registry is left empty.
+	 *
+	 * @param stream Source stream.
+	 *
+	 */
+	template<typename StreamType>
+	void Load(StreamType& stream, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Frozen copy of the registry, to be used by another thread (like a background @ref Save).
+	 *
+	 * Pages are shared copy-on-write (@ref PagedArray::Share): the freeze costs one reference per page, and the first
+	 * mutable access of a page by either registry afterwards copies that page. Components that are not trivially
+	 * copyable are copied by the freeze. Pointers obtained before the freeze (@ref Get, views, @ref Streams) must
+	 * not be written after it.
+	 *
+	 * @return Registry with the content of this one at the moment of the call.
+	 *
+	 */
+	NODISCARD Registry Freeze(RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Copy the pages of the signatures and of the arrays of the mask still shared with a frozen registry.
+	 *
+	 * The copy on write of a page is not thread safe, so jobs that use the same arrays at once need it first.
+	 * @ref ParallelEach, @ref ParallelView and the parallel levels of a @ref Scheduler call it before the jobs run.
+	 *
+	 */
+	void Unshare(const signature_t& mask, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Write the difference of the registry against a baseline state, for replication and replay.
+	 *
+	 * Only the pages of entity slots, signatures, ticks and components that differ are written, in blocks of
+	 * @ref ECS_DELTA_BLOCK_SIZE bytes. The baseline is meant to be a @ref Freeze of this registry taken at the
+	 * previous delta, then pages untouched since are skipped without a compare.
+	 *
+	 * @param baseline State the receiver has.
+	 * @param stream Target stream.
+	 *
+	 */
+	template<typename StreamType>
+	void SaveDelta(const Registry& baseline, StreamType& stream, RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief Apply a delta written by @ref SaveDelta.
+	 *
+	 * The registry must be in the baseline state, like after a @ref Load of it or after the previous delta.
+	 * On failure the registry is left empty.
+	 *
+	 */
+	template<typename StreamType>
+	void LoadDelta(StreamType& stream, RESULT_PARAM_DEFINE);
+
+public:
+	template<typename... Components>
+	void Enable(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	template<typename... Components>
+	void Disable(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	template<typename Component>
+	NODISCARD bool IsEnabled(entity_id_t id, RESULT_PARAM_DEFINE) const;
+
+public:
+	template<typename Component>
+	void Add(entity_id_t id, Component&& component, RESULT_PARAM_DEFINE);
+
+	template<typename Component>
+	void Remove(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Add one component to each entity.
+	 *
+	 * The ids must be unique and must not have the component yet. Components are moved from the span.
+	 *
+	 * @param ids Target entities.
+	 * @param components Components, in the same order of the ids.
+	 *
+	 */
+	template<typename Component>
+	void AddMany(eastl::span<const entity_id_t> ids, eastl::span<Component> components, RESULT_PARAM_DEFINE);
+
+	template<typename Component>
+	ComponentPtr<Component> Get(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	template<typename Component, typename Function>
+	void Each(Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Multi-component view.
+	 *
+	 * Iterates every entity that has all of the given components, starting from the smallest component set.
+	 * The signature is tested once per candidate entity, then the function is called as
+	 * function(entity_id_t, Components&...).
+	 *
+	 * @tparam Components Required component types.
+	 * @tparam Function Callable type, kept as template so it can be inlined.
+	 *
+	 */
+	template<typename... Components, typename Function>
+	void View(Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Parallel version of @ref Each.
+	 *
+	 * The component slots are split in ranges of grain size, rounded to whole cache lines, and executed by the
+	 * default @ref JobPool. The function is called concurrently for different components, so it must not change
+	 * the registry.
+	 *
+	 * @param grain Slots per job range.
+	 *
+	 */
+	template<typename Component, typename Function>
+	void ParallelEach(Function&& function, uint64_t grain = ECS_PARALLEL_GRAIN, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Parallel version of @ref View.
+	 *
+	 * The slots of the smallest component set are split as in @ref ParallelEach.
+	 *
+	 * @param grain Slots per job range.
+	 *
+	 */
+	template<typename... Components, typename Function>
+	void ParallelView(Function&& function, uint64_t grain = ECS_PARALLEL_GRAIN, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Streams of one page of a SoA component (@ref ComponentStorage::eSoa).
+	 *
+	 * The page holds the entities [page * ECS_PAGE_SIZE, (page + 1) * ECS_PAGE_SIZE), indexed by the offset of the id
+	 * inside the page. The streams are null when no entity of the page ever had the component.
+	 *
+	 */
+	template<typename Component>
+	NODISCARD SoaStreams Streams(uint64_t page, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Iterate the unique values of a shared component (@ref ComponentStorage::eShared) with the entities that
+	 * reference them, as function(const Component&, eastl::span<const entity_id_t>).
+	 *
+	 * The function is called once per value, so state like a material is bound once for the whole batch.
+	 *
+	 */
+	template<typename Component, typename Function>
+	void EachShared(Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Sort the storage of a dense component by key, with an LSD radix sort (@ref Detail::RadixSort).
+	 *
+	 * The key function is called once per component, as key(const Component&), and returns a 32 or 64-bit unsigned
+	 * integer. Equal keys keep their order. Views and @ref Each visit the components in the new order afterwards,
+	 * pointers from @ref Get are invalidated.
+	 *
+	 * @tparam Component Dense component type (@ref ComponentStorage::eDense), not @ref HierarchyComponent.
+	 *
+	 */
+	template<typename Component, typename Function>
+	void Sort(Function&& key, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Sort the storage of a dense component in the order of another component.
+	 *
+	 * Entities that have both components come first, in the storage order of Reference, the others follow in their
+	 * current order.
+	 *
+	 * @tparam Component Dense component type to sort.
+	 * @tparam Reference Component type that gives the order, it cannot be a tag or SoA component.
+	 *
+	 */
+	template<typename Component, typename Reference>
+	void SortAs(RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Create an owning group of dense components, the same group is returned by the next calls.
+	 *
+	 * The entities that have every component of the group are kept in the first slots of every array, in the same
+	 * order, so @ref EachGroup scans the arrays in parallel without lookups. Add and remove keep the group packed
+	 * with one swap per array. A component can be owned by one group only, and owned components cannot be sorted.
+	 * Registries that exchange deltas (@ref SaveDelta) must create the same groups.
+	 *
+	 * @tparam Components At least two different dense components (@ref ComponentStorage::eDense).
+	 * @return Entities in the group.
+	 *
+	 */
+	template<typename... Components>
+	uint64_t Group(RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Iterate an owning group (@ref Group), as function(entity_id_t, Components&...).
+	 *
+	 * The group is created on the first call. The function must not change the registry structure.
+	 *
+	 */
+	template<typename... Components, typename Function>
+	void EachGroup(Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Register the cached entity list of a component set (@ref EachQuery).
+	 *
+	 * The list is built here, then every signature change (add, remove, enable, disable and destroy) updates the
+	 * cached lists it affects. Registering is a structural change, so it is done before systems run, not from them.
+	 * Registering a set again keeps its list.
+	 *
+	 * @return Entities in the list.
+	 *
+	 */
+	template<typename... Components>
+	uint64_t Query(RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Iterate the entities that have every component through a cached entity list, as
+	 * function(entity_id_t, Components&...).
+	 *
+	 * Repeated queries skip the signature test of every entity done by @ref View, at the cost of one mask test per
+	 * cached query and structural change. The list must be registered by @ref Query, otherwise the call fails with
+	 * EcsQueryNotRegistered, so concurrent calls only read the cache. The function must not change the registry
+	 * structure. Frozen registries (@ref Freeze) start without cache.
+	 *
+	 */
+	template<typename... Components, typename Function>
+	void EachQuery(Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Drop the cached entity list of a component set (@ref EachQuery).
+	 */
+	template<typename... Components>
+	void ReleaseQuery(RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Write the ids of the entities whose signature matches the masks, in id order.
+	 *
+	 * An entity matches when it has every component of required, none of excluded and at least one of optional,
+	 * an empty optional mask accepts any entity with a component. Entities without components never match.
+	 * The signatures are scanned in bulk with SIMD (@ref Detail::FilterSignatures), so masks that no view covers,
+	 * like exclusions, are answered at close to memory bandwidth.
+	 *
+	 * @param required Required components.
+	 * @param excluded Excluded components.
+	 * @param optional Optional components.
+	 * @param ids Output, at least @ref Size ids.
+	 * @return Count of ids written.
+	 *
+	 */
+	uint64_t Filter(const signature_t& required, const signature_t& excluded, const signature_t& optional,
+					eastl::span<entity_id_t> ids, RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief @ref Filter with masks of type lists, ex: Filter<TypeList<A>, TypeList<Dead>>(ids).
+	 */
+	template<typename Required, typename Excluded = TypeTraits::TypeList<>,
+			 typename Optional = TypeTraits::TypeList<>>
+	uint64_t Filter(eastl::span<entity_id_t> ids, RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief Signature with the bits of the components.
+	 */
+	template<typename... Components>
+	NODISCARD static signature_t Mask(TypeTraits::TypeList<Components...> = {});
+
+public:
+	/**
+	 * @brief Attach an entity to a parent, the parent INVALID_ENTITY_ID makes it a root.
+	 *
+	 * Entities without @ref HierarchyComponent receive one. The subtree of the child is moved right after the parent
+	 * (roots after the last component), so only the components between the old and the new place shift.
+	 * Fails with EcsHierarchyCycle when the parent is inside the subtree of the child.
+	 *
+	 */
+	void SetParent(entity_id_t child, entity_id_t parent, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Parent of an entity, INVALID_ENTITY_ID for roots and entities without @ref HierarchyComponent.
+	 */
+	NODISCARD entity_id_t Parent(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Iterate the hierarchy in depth-first order, as function(entity_id_t, const HierarchyComponent&).
+	 *
+	 * Parents are visited before their children, disabled components included.
+	 *
+	 */
+	template<typename Function>
+	void EachHierarchy(Function&& function, RESULT_PARAM_DEFINE);
+
+public:
+	/**
+	 * @brief Current tick, stamped on components by @ref Add, @ref AddMany, mutable access of @ref Get and
+	 * @ref MarkChanged.
+	 */
+	NODISCARD tick_t Tick() const;
+
+	/**
+	 * @brief Start a new tick.
+	 *
+	 * @return Previous tick. A system keeps it as the since of its next @ref Changed or @ref Added, so every change
+	 * made after this call is seen exactly once.
+	 *
+	 */
+	tick_t AdvanceTick();
+
+	template<typename Component>
+	void MarkChanged(entity_id_t id, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Iterate the components changed after the since tick, as function(entity_id_t, Component&).
+	 *
+	 * Adding a component also changes it. Writes done by the function are not stamped, use @ref MarkChanged.
+	 *
+	 */
+	template<typename Component, typename Function>
+	void Changed(tick_t since, Function&& function, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Iterate the components added after the since tick, as function(entity_id_t, Component&).
+	 */
+	template<typename Component, typename Function>
+	void Added(tick_t since, Function&& function, RESULT_PARAM_DEFINE);
+
+public:
+	NODISCARD uint64_t Capacity(RESULT_PARAM_DEFINE) const;
+	NODISCARD uint64_t Size(RESULT_PARAM_DEFINE) const;
+	NODISCARD bool	   Contains(entity_id_t id, RESULT_PARAM_DEFINE) const;
+	void			   Reserve(uint64_t capacity, RESULT_PARAM_DEFINE);
+	void			   Clear(RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Occupancy and memory of every component array and of the entity arrays.
+	 *
+	 * Only counters are read and page directories walked, so it is cheap enough to sample every frame.
+	 * Tags have no array and are reported as not constructed.
+	 *
+	 */
+	NODISCARD RegistryStats Stats(RESULT_PARAM_DEFINE) const;
+
+	/**
+	 * @brief Move components of sparse storage from the end of the array into its holes, see
+	 * @ref ComponentStats::free_slots.
+	 *
+	 * Each call moves or cuts off at most budget slots, so heavy churn is undone over several frames with a bounded
+	 * cost per frame. Iteration then walks fewer holes. Pointers to moved components are invalidated, it must not
+	 * be called while iterating.
+	 *
+	 * @param budget Maximum slots moved or cut off the end, each costs one component move at most.
+	 * @return Holes left, 0 when the array is compact.
+	 *
+	 */
+	template<typename Component>
+	uint64_t Compact(uint64_t budget, RESULT_PARAM_DEFINE);
+
+private:
+	template<typename Component>
+	void SetEnabledInternal(entity_id_t id, bool value, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief Shared body of the views, iterate is called as iterate(driver_array, visitor).
+	 */
+	template<typename... Components, typename Function, typename Iterate>
+	void ViewInternal(Function&& function, Iterate&& iterate);
+
+	/**
+	 * @brief Call the view function for one entity whose signature matches, when every component holds data.
+	 */
+	template<typename... Components, typename Function>
+	void VisitView(entity_id_t id, Function& function);
+
+	static uint64_t AlignGrain(uint64_t grain, uint64_t step);
+
+	/**
+	 * @brief Shared instance handed out for tag components, it has no state.
+	 */
+	template<typename Component>
+	static Component& TagInstance();
+
+	template<typename Component>
+	NODISCARD Component* GetComponentData(entity_id_t id);
+
+	/**
+	 * @brief Component of a view, SoA components are loaded to the slot.
+	 */
+	template<typename Component>
+	NODISCARD Component* GetViewComponent(entity_id_t id, view_slot_t<Component>& slot);
+
+	/**
+	 * @brief Store the slot of a SoA component back after the view function, nothing for other components.
+	 */
+	template<typename Component>
+	void StoreViewComponent(entity_id_t id, const view_slot_t<Component>& slot);
+
+	/**
+	 * @brief Iterate entity ids in [begin, end) whose signature has every bit of the mask.
+	 */
+	template<typename Function>
+	void EachSignature(const signature_t& mask, uint64_t begin, uint64_t end, Function&& function) const;
+
+	template<bool Added, typename Component, typename Function>
+	void EachSinceInternal(tick_t since, Function&& function);
+
+	void PlaybackInternal(eastl::span<CommandBuffer<TypeList>* const> buffers, RESULT_PARAM_DEFINE);
+
+	/**
+	 * @brief End of the subtree that starts at the hierarchy slot first.
+	 */
+	NODISCARD uint64_t HierarchySubtreeEnd(uint64_t first);
+
+	/**
+	 * @brief Attach the children of an entity to its parent and move it to the last hierarchy slot, so the swap and
+	 * pop of the removal keeps the depth-first order.
+	 */
+	void DetachHierarchy(entity_id_t id);
+
+	/**
+	 * @brief Owning group, the first size slots of every owned array hold the same entities in the same order.
+	 */
+	struct GroupState
+	{
+		signature_t owned;
+		uint64_t	size;
+	};
+
+	NODISCARD GroupState& GroupOf(uint64_t component_id);
+
+	/**
+	 * @brief Move the entity to the end of the group when it has every owned component and is not in it yet.
+	 */
+	void GroupEnter(GroupState& group, entity_id_t id);
+
+	/**
+	 * @brief Move the entity out of the group, before one of its owned components is removed.
+	 */
+	void GroupLeave(GroupState& group, entity_id_t id);
+
+	/**
+	 * @brief Pack the groups again after the arrays were replaced (@ref Load, @ref LoadDelta).
+	 */
+	void RebuildGroups();
+
+	/**
+	 * @brief Cached entity list of a query, entities leave it with swap and pop.
+	 */
+	struct QueryState
+	{
+		signature_t				   mask;
+		eastl::vector<entity_id_t> entities;
+		PagedArray<uint32_t>	   index;
+	};
+
+	static constexpr uint32_t INVALID_QUERY_INDEX = eastl::numeric_limits<uint32_t>::max();
+
+	NODISCARD QueryState* FindQuery(const signature_t& mask);
+
+	/**
+	 * @brief Update the cached queries after the signature of an entity changed, before is the old signature.
+	 */
+	void QueryUpdate(entity_id_t id, const signature_t& before);
+	void QueryInsert(QueryState& query, entity_id_t id);
+	void QueryErase(QueryState& query, entity_id_t id);
+
+	/**
+	 * @brief Fill the cached queries again after the signatures were replaced (@ref Load, @ref LoadDelta).
+	 */
+	void RebuildQueries();
+
+	template<uint64_t Index>
+	NODISCARD bool ContainsComponentsMap(const signature_t& mask, entity_id_t id);
+
+	/**
+	 * @brief Slot of the entity in the first array of the mask, INVALID_ENTITY_ID when it has no component there.
+	 */
+	template<uint64_t Index>
+	NODISCARD uint64_t SlotComponentsMap(const signature_t& mask, entity_id_t id);
+
+	template<uint64_t Index>
+	void SwapComponentsMap(const signature_t& mask, entity_id_t id, uint64_t slot);
+
+	template<uint64_t Index>
+	void FillGroupComponentsMap(GroupState& group);
+
+	void GrowEntities();
+
+	/**
+	 * @brief Tell whether the id was created and not destroyed since.
+	 */
+	NODISCARD bool IsLive(entity_id_t id) const;
+
+	/**
+	 * @brief Swap a live id with the last live id of the stack, so it is the first free id once the cursor drops.
+	 */
+	void ReleaseEntity(entity_id_t id, uint64_t last);
+
+	/**
+	 * @brief Rebuild the positions from a loaded stack, false when the stack is not a permutation of the ids.
+	 */
+	NODISCARD bool RebuildPositions();
+
+private:
+	tick_t					  tick_{1};
+	eastl::atomic<uint64_t>	  ecursor_{};
+	PagedArray<entity_id_t>	  entities_;
+	PagedArray<entity_id_t>	  positions_;
+	PagedArray<signature_t>	  signatures_;
+	PagedArray<generation_t>  generations_;
+	component_map_tuple_t	  components_map_;
+	eastl::vector<GroupState> groups_;
+	signature_t				  owned_{};
+	eastl::vector<QueryState> queries_;
+};
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentArray<Component>::~ComponentArray()
+{
+	if constexpr (!eastl::is_trivially_destructible_v<Component>)
+	{
+		Each([](entity_id_t, Component& component) { component.~Component(); });
+	}
+	cursor_fl_ = INVALID_COMPONENT_ID;
+	dcursor_ = size_ = 0;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Add(const entity_id_t id, Component&& component, const tick_t tick,
+													   RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (Contains(id))
+	{
+		RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+	}
+
+	const uint64_t l_index = AcquireSlot();
+	Bind(id, l_index, tick);
+	new (&data_[l_index]) Component{eastl::move(component)};
+	++size_;
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::AddMany(const eastl::span<const entity_id_t> ids,
+															 const eastl::span<Component>	   components,
+															 const tick_t tick, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (ids.size() != components.size())
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+	for (const entity_id_t l_id : ids)
+	{
+		if (Contains(l_id))
+		{
+			RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+		}
+	}
+
+	AddRange(ids, tick, [&](Component* const data, const uint64_t first, const uint64_t count) {
+		if constexpr (eastl::is_trivially_copyable_v<Component>)
+		{
+			memcpy(static_cast<void*>(data), components.data() + first, count * sizeof(Component));
+		}
+		else
+		{
+			for (uint64_t l_index = 0; l_index < count; ++l_index)
+			{
+				new (data + l_index) Component{eastl::move(components[first + l_index])};
+			}
+		}
+	});
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::AddCopies(const eastl::span<const entity_id_t> ids,
+															   const entity_id_t source, const tick_t tick)
+{
+	// Copied out first, filling the pages may unshare the page of the source
+	const PagedArray<Component>& l_data = data_;
+	const Component				 l_component{l_data[eindex_[source]]};
+	AddRange(ids, tick, [&](Component* const data, uint64_t, const uint64_t count) {
+		eastl::uninitialized_fill_n(data, count, l_component);
+	});
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Construct>
+void Registry<TypeList>::ComponentArray<Component>::AddRange(const eastl::span<const entity_id_t> ids,
+															  const tick_t tick, Construct&& construct)
+{
+	const uint64_t l_count = ids.size();
+	uint64_t	   l_done  = 0;
+
+	// Holes of sparse storage are filled one by one, only the tail is contiguous
+	if constexpr (!DENSE)
+	{
+		for (; l_done < l_count && cursor_fl_ != INVALID_COMPONENT_ID; ++l_done)
+		{
+			const uint64_t l_index = AcquireSlot();
+			Bind(ids[l_done], l_index, tick);
+			construct(&data_[l_index], l_done, 1);
+		}
+	}
+
+	ASSERT(dcursor_ + (l_count - l_done) < INVALID_INDEX);
+
+	constexpr uint64_t l_page_size = PagedArray<Component>::PAGE_SIZE;
+	while (l_done < l_count)
+	{
+		const uint64_t l_begin	= dcursor_;
+		const uint64_t l_page	= PagedArray<Component>::PageOf(l_begin);
+		const uint64_t l_offset = PagedArray<Component>::OffsetOf(l_begin);
+		const uint64_t l_chunk	= eastl::min(l_page_size - l_offset, l_count - l_done);
+
+		entity_id_t* const l_entities = dentity_.AssurePage(l_page) + l_offset;
+		construct(data_.AssurePage(l_page) + l_offset, l_done, l_chunk);
+		memcpy(l_entities, ids.data() + l_done, l_chunk * sizeof(entity_id_t));
+		eastl::fill_n(added_.AssurePage(l_page) + l_offset, l_chunk, tick);
+		eastl::fill_n(changed_.AssurePage(l_page) + l_offset, l_chunk, tick);
+
+		for (uint64_t l_index = 0; l_index < l_chunk; ++l_index)
+		{
+			const entity_id_t l_id = ids[l_done + l_index];
+			eindex_.AssurePage(PagedArray<index_t>::PageOf(l_id), INVALID_INDEX);
+			eindex_[l_id] = static_cast<index_t>(l_begin + l_index);
+		}
+
+		dcursor_ += l_chunk;
+		l_done += l_chunk;
+	}
+
+	size_ += l_count;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::ComponentArray<Component>::AcquireSlot()
+{
+	if (DENSE || cursor_fl_ == INVALID_COMPONENT_ID)
+	{
+		ASSERT(dcursor_ < INVALID_INDEX);
+		const uint64_t l_index = dcursor_++;
+		if (PagedArray<Component>::OffsetOf(l_index) == 0)
+		{
+			data_.AssurePage(PagedArray<Component>::PageOf(l_index));
+			dentity_.AssurePage(PagedArray<entity_id_t>::PageOf(l_index));
+			added_.AssurePage(PagedArray<tick_t>::PageOf(l_index));
+			changed_.AssurePage(PagedArray<tick_t>::PageOf(l_index));
+		}
+		return l_index;
+	}
+
+	const uint64_t l_index = cursor_fl_;
+	UnlinkFree(l_index);
+	return l_index;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::LinkFree(const uint64_t index)
+{
+	reinterpret_cast<CursorFreeList&>(data_[index]).next = cursor_fl_;
+	added_[index]										 = FREE_LIST_HEAD;
+	if (cursor_fl_ != INVALID_COMPONENT_ID)
+	{
+		added_[cursor_fl_] = static_cast<tick_t>(index);
+	}
+	cursor_fl_ = index;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::UnlinkFree(const uint64_t index)
+{
+	const uint64_t l_next	  = reinterpret_cast<CursorFreeList&>(data_[index]).next;
+	const tick_t   l_previous = added_[index];
+	if (l_previous == FREE_LIST_HEAD)
+	{
+		cursor_fl_ = l_next;
+	}
+	else
+	{
+		reinterpret_cast<CursorFreeList&>(data_[l_previous]).next = l_next;
+	}
+	if (l_next != INVALID_COMPONENT_ID)
+	{
+		added_[l_next] = l_previous;
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::ComponentArray<Component>::Compact(uint64_t budget)
+{
+	static_assert(!DENSE, "Only sparse storage has holes to compact.");
+
+	// Every hole below the cursor is on the free list, so the array is compact when the cursor meets the size
+	for (; budget > 0 && dcursor_ > size_; --budget)
+	{
+		const uint64_t	  l_last = dcursor_ - 1;
+		const entity_id_t l_id	 = dentity_[l_last];
+		if (l_id == INVALID_ENTITY_ID)
+		{
+			UnlinkFree(l_last);
+			--dcursor_;
+			continue;
+		}
+
+		// The end is live, so the first hole is below it
+		const uint64_t l_hole = cursor_fl_;
+		UnlinkFree(l_hole);
+		new (&data_[l_hole]) Component{eastl::move(data_[l_last])};
+		data_[l_last].~Component();
+		dentity_[l_hole] = l_id;
+		added_[l_hole]	 = added_[l_last];
+		changed_[l_hole] = changed_[l_last];
+		eindex_[l_id]	 = static_cast<index_t>(l_hole);
+		--dcursor_;
+	}
+	return dcursor_ - size_;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Bind(const entity_id_t id, const uint64_t index, const tick_t tick)
+{
+	eindex_.AssurePage(PagedArray<index_t>::PageOf(id), INVALID_INDEX);
+	eindex_[id]		= static_cast<index_t>(index);
+	dentity_[index] = id;
+	added_[index]	= tick;
+	changed_[index] = tick;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Rotate(const uint64_t first, const uint64_t middle,
+														   const uint64_t last)
+{
+	static_assert(DENSE, "Only dense storage can be rotated, sparse storage has holes.");
+	if (first == middle || middle == last)
+	{
+		return;
+	}
+	Reverse(first, middle);
+	Reverse(middle, last);
+	Reverse(first, last);
+	for (uint64_t l_index = first; l_index < last; ++l_index)
+	{
+		eindex_[dentity_[l_index]] = static_cast<index_t>(l_index);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Permute(const eastl::vector<uint32_t>& order)
+{
+	static_assert(DENSE, "Only dense storage can be permuted, sparse storage has holes.");
+	ASSERT(order.size() == dcursor_);
+	const auto l_gather = [&](auto& array)
+	{
+		using value_t = eastl::decay_t<decltype(array[0])>;
+		eastl::vector<value_t> l_values{};
+		l_values.reserve(dcursor_);
+		for (uint64_t l_index = 0; l_index < dcursor_; ++l_index)
+		{
+			l_values.push_back(eastl::move(array[order[l_index]]));
+		}
+		for (uint64_t l_index = 0; l_index < dcursor_; ++l_index)
+		{
+			array[l_index] = eastl::move(l_values[l_index]);
+		}
+	};
+	l_gather(data_);
+	l_gather(dentity_);
+	l_gather(added_);
+	l_gather(changed_);
+	for (uint64_t l_index = 0; l_index < dcursor_; ++l_index)
+	{
+		eindex_[dentity_[l_index]] = static_cast<index_t>(l_index);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Swap(const uint64_t first, const uint64_t second)
+{
+	static_assert(DENSE, "Only dense storage can swap slots, sparse storage has holes.");
+	if (first == second)
+	{
+		return;
+	}
+	eastl::swap(data_[first], data_[second]);
+	eastl::swap(dentity_[first], dentity_[second]);
+	eastl::swap(added_[first], added_[second]);
+	eastl::swap(changed_[first], changed_[second]);
+	eindex_[dentity_[first]]  = static_cast<index_t>(first);
+	eindex_[dentity_[second]] = static_cast<index_t>(second);
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Reverse(uint64_t first, uint64_t last)
+{
+	for (; first + 1 < last; ++first, --last)
+	{
+		eastl::swap(data_[first], data_[last - 1]);
+		eastl::swap(dentity_[first], dentity_[last - 1]);
+		eastl::swap(added_[first], added_[last - 1]);
+		eastl::swap(changed_[first], changed_[last - 1]);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!Contains(id))
+	{
+		RESULT_ERROR(EcsComponentDataNotAdded);
+	}
+	const uint64_t l_index_removed_entity = eindex_[id];
+	eindex_[id]							  = INVALID_INDEX;
+	--size_;
+
+	if constexpr (DENSE)
+	{
+		// Swap and pop, the last component fills the hole
+		const uint64_t l_index_last = --dcursor_;
+		if (l_index_removed_entity != l_index_last)
+		{
+			const entity_id_t l_last_entity	 = dentity_[l_index_last];
+			data_[l_index_removed_entity]	 = eastl::move(data_[l_index_last]);
+			dentity_[l_index_removed_entity] = l_last_entity;
+			added_[l_index_removed_entity]	 = added_[l_index_last];
+			changed_[l_index_removed_entity] = changed_[l_index_last];
+			eindex_[l_last_entity]			 = static_cast<index_t>(l_index_removed_entity);
+		}
+		data_[l_index_last].~Component();
+	}
+	else
+	{
+		data_[l_index_removed_entity].~Component();
+		dentity_[l_index_removed_entity] = INVALID_ENTITY_ID;
+		LinkFree(l_index_removed_entity);
+	}
+
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::ComponentArray<Component>::Each(Function&& function)
+{
+	EachRange(0, dcursor_, eastl::forward<Function>(function));
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::ComponentArray<Component>::EachRange(const uint64_t begin, uint64_t end,
+															   Function&& function)
+{
+	constexpr uint64_t l_page_size = PagedArray<Component>::PAGE_SIZE;
+
+	end = eastl::min(end, dcursor_);
+	for (uint64_t l_begin = begin; l_begin < end;)
+	{
+		const uint64_t			 l_page		= PagedArray<Component>::PageOf(l_begin);
+		const uint64_t			 l_offset	= PagedArray<Component>::OffsetOf(l_begin);
+		Component* const		 l_data		= data_.Page(l_page);
+		const entity_id_t* const l_entities = dentity_.Page(l_page);
+		const uint64_t			 l_count	= eastl::min(l_page_size, l_offset + end - l_begin);
+		l_begin += l_count - l_offset;
+
+		for (uint64_t l_index = l_offset; l_index < l_count; ++l_index)
+		{
+			const entity_id_t l_id = l_entities[l_index];
+			if constexpr (!DENSE)
+			{
+				if (l_id == INVALID_ENTITY_ID)
+				{
+					continue;
+				}
+			}
+			function(l_id, l_data[l_index]);
+		}
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+Component* Registry<TypeList>::ComponentArray<Component>::Get(const entity_id_t id)
+{
+	const index_t* l_index = eindex_.TryGet(id);
+	if (!l_index || *l_index == INVALID_INDEX)
+	{
+		return nullptr;
+	}
+	return &data_[*l_index];
+}
+
+template<typename TypeList>
+template<typename Component>
+tick_t* Registry<TypeList>::ComponentArray<Component>::ChangedTick(const entity_id_t id)
+{
+	const index_t* l_index = eindex_.TryGet(id);
+	if (!l_index || *l_index == INVALID_INDEX)
+	{
+		return nullptr;
+	}
+	return &changed_[*l_index];
+}
+
+template<typename TypeList>
+template<typename Component>
+template<bool Added, typename Function>
+void Registry<TypeList>::ComponentArray<Component>::EachSince(const tick_t since, Function&& function)
+{
+	constexpr uint64_t		  l_page_size = PagedArray<Component>::PAGE_SIZE;
+	const PagedArray<tick_t>& l_ticks	  = Added ? added_ : changed_;
+
+	for (uint64_t l_begin = 0; l_begin < dcursor_; l_begin += l_page_size)
+	{
+		const uint64_t			 l_page		= PagedArray<Component>::PageOf(l_begin);
+		const tick_t* const		 l_tick		= l_ticks.Page(l_page);
+		const entity_id_t* const l_entities = dentity_.Page(l_page);
+		const uint64_t			 l_count	= eastl::min(l_page_size, dcursor_ - l_begin);
+
+		for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+		{
+			// Holes of sparse storage keep free list links in the added tick, the entity tells them apart
+			if (l_tick[l_index] > since && (DENSE || l_entities[l_index] != INVALID_ENTITY_ID))
+			{
+				function(l_entities[l_index], data_.Page(l_page)[l_index]);
+			}
+		}
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+bool Registry<TypeList>::ComponentArray<Component>::Contains(const entity_id_t id) const
+{
+	const index_t* l_index = eindex_.TryGet(id);
+	return l_index && *l_index != INVALID_INDEX;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::ComponentArray<Component>::Slots() const
+{
+	return dcursor_;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::ComponentArray<Component>::Size() const
+{
+	return size_;
+}
+
+template<typename TypeList>
+template<typename Component>
+ComponentStats Registry<TypeList>::ComponentArray<Component>::Stats() const
+{
+	// Every slot below the cursor that is not live is on the free list
+	const uint64_t l_free = dcursor_ - size_;
+	return ComponentStats{true,
+						  data_.Capacity(),
+						  size_,
+						  l_free,
+						  data_.Bytes(),
+						  eindex_.Bytes() + dentity_.Bytes(),
+						  added_.Bytes() + changed_.Bytes(),
+						  dcursor_ ? static_cast<float32_t>(l_free) / static_cast<float32_t>(dcursor_) : 0.f};
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::ComponentArray<Component>::Write(StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[3] = {cursor_fl_, dcursor_, size_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(eindex_.Save(stream, eindex_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.Save(stream, dcursor_, RESULT_ARG_PASS));
+
+	if constexpr (eastl::is_trivially_copyable_v<Component>)
+	{
+		RESULT_ENSURE_CALL_NOLOG(data_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	}
+	else
+	{
+		for (uint64_t l_index = 0; l_index < dcursor_; ++l_index)
+		{
+			if (!DENSE && dentity_[l_index] == INVALID_ENTITY_ID)
+			{
+				const uint64_t l_next = reinterpret_cast<const CursorFreeList&>(data_[l_index]).next;
+				RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(&l_next, sizeof l_next, RESULT_ARG_PASS),
+											  StreamFailedToWrite);
+				continue;
+			}
+			RESULT_CONDITION_ENSURE_NOLOG(Stream::Impl<Component>::Write(stream, data_[l_index], RESULT_ARG_PASS),
+										  StreamFailedToWrite);
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::ComponentArray<Component>::Read(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_header[3]{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS), StreamFailedToRead);
+	RESULT_CONDITION_ENSURE_NOLOG(l_header[1] < INVALID_INDEX && l_header[2] <= l_header[1], EcsInvalidSnapshot);
+	RESULT_ENSURE_CALL_NOLOG(eindex_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.Load(stream, RESULT_ARG_PASS));
+	RESULT_CONDITION_ENSURE_NOLOG(dentity_.Capacity() >= l_header[1] && changed_.Capacity() >= l_header[1],
+								  EcsInvalidSnapshot);
+
+	// The slot cursor only grows over constructed components, so a failed load destroys just those
+	if constexpr (eastl::is_trivially_copyable_v<Component>)
+	{
+		RESULT_ENSURE_CALL_NOLOG(data_.Load(stream, RESULT_ARG_PASS));
+		RESULT_CONDITION_ENSURE_NOLOG(data_.Capacity() >= l_header[1], EcsInvalidSnapshot);
+		dcursor_ = l_header[1];
+	}
+	else
+	{
+		for (uint64_t l_index = 0; l_index < l_header[1]; ++l_index)
+		{
+			Component* const l_component = data_.AssurePage(PagedArray<Component>::PageOf(l_index)) +
+										   PagedArray<Component>::OffsetOf(l_index);
+			if (!DENSE && dentity_[l_index] == INVALID_ENTITY_ID)
+			{
+				uint64_t& l_next = reinterpret_cast<CursorFreeList*>(l_component)->next;
+				RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(&l_next, sizeof l_next, RESULT_ARG_PASS),
+											  StreamFailedToRead);
+				dcursor_ = l_index + 1;
+				continue;
+			}
+			new (l_component) Component{};
+			dcursor_ = l_index + 1;
+			RESULT_CONDITION_ENSURE_NOLOG(Stream::Impl<Component>::Read(stream, *l_component, RESULT_ARG_PASS),
+										  StreamFailedToRead);
+		}
+	}
+	cursor_fl_ = l_header[0];
+	size_	   = l_header[2];
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Freeze(ComponentArray& frozen)
+{
+	if constexpr (eastl::is_trivially_copyable_v<Component>)
+	{
+		frozen.data_ = data_.Share();
+	}
+	else
+	{
+		const PagedArray<entity_id_t>& l_entities = dentity_;
+		for (uint64_t l_index = 0; l_index < dcursor_; ++l_index)
+		{
+			Component* const l_component = frozen.data_.AssurePage(PagedArray<Component>::PageOf(l_index)) +
+										   PagedArray<Component>::OffsetOf(l_index);
+			if (!DENSE && l_entities[l_index] == INVALID_ENTITY_ID)
+			{
+				reinterpret_cast<CursorFreeList*>(l_component)->next =
+					reinterpret_cast<CursorFreeList&>(data_[l_index]).next;
+				continue;
+			}
+			new (l_component) Component{data_[l_index]};
+		}
+	}
+	frozen.cursor_fl_ = cursor_fl_;
+	frozen.dcursor_	  = dcursor_;
+	frozen.size_	  = size_;
+	frozen.dentity_	  = dentity_.Share();
+	frozen.eindex_	  = eindex_.Share();
+	frozen.added_	  = added_.Share();
+	frozen.changed_	  = changed_.Share();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArray<Component>::Unshare()
+{
+	data_.UnshareAll();
+	dentity_.UnshareAll();
+	eindex_.UnshareAll();
+	added_.UnshareAll();
+	changed_.UnshareAll();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::ComponentArray<Component>::WriteDelta(const ComponentArray& baseline, StreamType& stream,
+															   RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[3] = {cursor_fl_, dcursor_, size_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(eindex_.SaveDelta(baseline.eindex_, stream, eindex_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.SaveDelta(baseline.dentity_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.SaveDelta(baseline.added_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.SaveDelta(baseline.changed_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(data_.SaveDelta(baseline.data_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::ComponentArray<Component>::ReadDelta(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_header[3]{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS), StreamFailedToRead);
+	RESULT_CONDITION_ENSURE_NOLOG(l_header[1] < INVALID_INDEX && l_header[2] <= l_header[1], EcsInvalidSnapshot);
+	RESULT_ENSURE_CALL_NOLOG(eindex_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(data_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_CONDITION_ENSURE_NOLOG(dentity_.Capacity() >= l_header[1] && changed_.Capacity() >= l_header[1] &&
+									  data_.Capacity() >= l_header[1],
+								  EcsInvalidSnapshot);
+	cursor_fl_ = l_header[0];
+	dcursor_   = l_header[1];
+	size_	   = l_header[2];
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::Add(const entity_id_t id, Component&& component,
+															const tick_t tick, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (Contains(id))
+	{
+		RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+	}
+
+	// New pages hold default values, so kernels can run over whole pages
+	const uint64_t	l_page = stream_t::PageOf(id);
+	const glm::vec3 l_fill = Component{}.value;
+	x_.AssurePage(l_page, l_fill.x);
+	y_.AssurePage(l_page, l_fill.y);
+	z_.AssurePage(l_page, l_fill.z);
+	bits_.AssurePage(bits_t::PageOf(id / 64), uint64_t{0});
+	added_.AssurePage(l_page);
+	changed_.AssurePage(l_page);
+
+	Store(id, component.value);
+	added_[id]	 = tick;
+	changed_[id] = tick;
+	bits_[id / 64] |= uint64_t{1} << (id % 64);
+	slots_ = eastl::max(slots_, id + 1);
+	++size_;
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!Contains(id))
+	{
+		RESULT_ERROR(EcsComponentDataNotAdded);
+	}
+	bits_[id / 64] &= ~(uint64_t{1} << (id % 64));
+	Store(id, Component{}.value);
+	--size_;
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::AddMany(const eastl::span<const entity_id_t> ids,
+																const eastl::span<Component>	  components,
+																const tick_t tick, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (ids.size() != components.size())
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+	for (const entity_id_t l_id : ids)
+	{
+		if (Contains(l_id))
+		{
+			RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+		}
+	}
+	for (uint64_t l_index = 0; l_index < ids.size(); ++l_index)
+	{
+		Add(ids[l_index], eastl::move(components[l_index]), tick);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::AddCopies(const eastl::span<const entity_id_t> ids,
+																  const entity_id_t source, const tick_t tick)
+{
+	Component l_component{};
+	l_component.value = Load(source);
+	for (const entity_id_t l_id : ids)
+	{
+		Component l_copy{l_component};
+		Add(l_id, eastl::move(l_copy), tick);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SoaComponentArray<Component>::Each(Function&& function)
+{
+	EachRange(0, slots_, eastl::forward<Function>(function));
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SoaComponentArray<Component>::EachRange(const uint64_t begin, uint64_t end,
+																  Function&& function)
+{
+	EachEntityRange(begin, end, [&](const entity_id_t id) {
+		Component l_component{};
+		l_component.value = Load(id);
+		function(id, l_component);
+		Store(id, l_component.value);
+	});
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SoaComponentArray<Component>::EachEntityRange(const uint64_t begin, uint64_t end,
+																		Function&& function) const
+{
+	end = eastl::min(end, slots_);
+	for (uint64_t l_id = begin; l_id < end;)
+	{
+		const uint64_t* l_word = bits_.TryGet(l_id / 64);
+		if (!l_word || (*l_word >> (l_id % 64)) == 0)
+		{
+			// Nothing else in this word
+			l_id = (l_id / 64 + 1) * 64;
+			continue;
+		}
+		if (*l_word & (uint64_t{1} << (l_id % 64)))
+		{
+			function(entity_id_t{l_id});
+		}
+		++l_id;
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+template<bool Added, typename Function>
+void Registry<TypeList>::SoaComponentArray<Component>::EachSince(const tick_t since, Function&& function)
+{
+	const PagedArray<tick_t>& l_ticks = Added ? added_ : changed_;
+	EachEntityRange(0, slots_, [&](const entity_id_t id) {
+		if (l_ticks[id] > since)
+		{
+			Component l_component{};
+			l_component.value = Load(id);
+			function(id, l_component);
+			Store(id, l_component.value);
+		}
+	});
+}
+
+template<typename TypeList>
+template<typename Component>
+tick_t* Registry<TypeList>::SoaComponentArray<Component>::ChangedTick(const entity_id_t id)
+{
+	return Contains(id) ? &changed_[id] : nullptr;
+}
+
+template<typename TypeList>
+template<typename Component>
+glm::vec3 Registry<TypeList>::SoaComponentArray<Component>::Load(const entity_id_t id) const
+{
+	return glm::vec3{x_[id], y_[id], z_[id]};
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::Store(const entity_id_t id, const glm::vec3& value)
+{
+	// Streams are compared through the const arrays, so frozen pages are only copied when a value changed
+	const auto l_store = [id](stream_t& stream, const float32_t value) {
+		const stream_t& l_stream = stream;
+		if (memcmp(&l_stream[id], &value, sizeof(float32_t)) != 0)
+		{
+			stream[id] = value;
+		}
+	};
+	l_store(x_, value.x);
+	l_store(y_, value.y);
+	l_store(z_, value.z);
+}
+
+template<typename TypeList>
+template<typename Component>
+SoaStreams Registry<TypeList>::SoaComponentArray<Component>::Streams(const uint64_t page)
+{
+	return SoaStreams{x_.Page(page), y_.Page(page), z_.Page(page)};
+}
+
+template<typename TypeList>
+template<typename Component>
+bool Registry<TypeList>::SoaComponentArray<Component>::Contains(const entity_id_t id) const
+{
+	const uint64_t* l_word = bits_.TryGet(id / 64);
+	return l_word && (*l_word & (uint64_t{1} << (id % 64)));
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::SoaComponentArray<Component>::Size() const
+{
+	return size_;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::SoaComponentArray<Component>::Slots() const
+{
+	return slots_;
+}
+
+template<typename TypeList>
+template<typename Component>
+ComponentStats Registry<TypeList>::SoaComponentArray<Component>::Stats() const
+{
+	const uint64_t l_free = slots_ - size_;
+	return ComponentStats{true,
+						  x_.Capacity(),
+						  size_,
+						  l_free,
+						  x_.Bytes() + y_.Bytes() + z_.Bytes(),
+						  bits_.Bytes(),
+						  added_.Bytes() + changed_.Bytes(),
+						  slots_ ? static_cast<float32_t>(l_free) / static_cast<float32_t>(slots_) : 0.f};
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SoaComponentArray<Component>::Write(StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[2] = {size_, slots_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	for (const stream_t* l_stream : {&x_, &y_, &z_})
+	{
+		RESULT_ENSURE_CALL_NOLOG(l_stream->Save(stream, l_stream->Capacity(), RESULT_ARG_PASS));
+	}
+	RESULT_ENSURE_CALL_NOLOG(bits_.Save(stream, bits_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.Save(stream, added_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.Save(stream, changed_.Capacity(), RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SoaComponentArray<Component>::Read(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_header[2]{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS), StreamFailedToRead);
+	RESULT_CONDITION_ENSURE_NOLOG(l_header[0] <= l_header[1], EcsInvalidSnapshot);
+	for (stream_t* l_stream : {&x_, &y_, &z_})
+	{
+		RESULT_ENSURE_CALL_NOLOG(l_stream->Load(stream, RESULT_ARG_PASS));
+	}
+	RESULT_ENSURE_CALL_NOLOG(bits_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.Load(stream, RESULT_ARG_PASS));
+	RESULT_CONDITION_ENSURE_NOLOG(x_.Capacity() >= l_header[1] && y_.Capacity() >= l_header[1] &&
+									  z_.Capacity() >= l_header[1] && bits_.Capacity() * 64 >= l_header[1] &&
+									  added_.Capacity() >= l_header[1] && changed_.Capacity() >= l_header[1],
+								  EcsInvalidSnapshot);
+	size_  = l_header[0];
+	slots_ = l_header[1];
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::Freeze(SoaComponentArray& frozen)
+{
+	frozen.size_	= size_;
+	frozen.slots_	= slots_;
+	frozen.x_		= x_.Share();
+	frozen.y_		= y_.Share();
+	frozen.z_		= z_.Share();
+	frozen.bits_	= bits_.Share();
+	frozen.added_	= added_.Share();
+	frozen.changed_ = changed_.Share();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SoaComponentArray<Component>::Unshare()
+{
+	x_.UnshareAll();
+	y_.UnshareAll();
+	z_.UnshareAll();
+	bits_.UnshareAll();
+	added_.UnshareAll();
+	changed_.UnshareAll();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SoaComponentArray<Component>::WriteDelta(const SoaComponentArray& baseline,
+																  StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[2] = {size_, slots_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(x_.SaveDelta(baseline.x_, stream, x_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(y_.SaveDelta(baseline.y_, stream, y_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(z_.SaveDelta(baseline.z_, stream, z_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(bits_.SaveDelta(baseline.bits_, stream, bits_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.SaveDelta(baseline.added_, stream, added_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.SaveDelta(baseline.changed_, stream, changed_.Capacity(), RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SoaComponentArray<Component>::ReadDelta(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_header[2]{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS), StreamFailedToRead);
+	RESULT_CONDITION_ENSURE_NOLOG(l_header[0] <= l_header[1], EcsInvalidSnapshot);
+	for (stream_t* l_stream : {&x_, &y_, &z_})
+	{
+		RESULT_ENSURE_CALL_NOLOG(l_stream->LoadDelta(stream, RESULT_ARG_PASS));
+	}
+	RESULT_ENSURE_CALL_NOLOG(bits_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_CONDITION_ENSURE_NOLOG(x_.Capacity() >= l_header[1] && y_.Capacity() >= l_header[1] &&
+									  z_.Capacity() >= l_header[1] && bits_.Capacity() * 64 >= l_header[1] &&
+									  added_.Capacity() >= l_header[1] && changed_.Capacity() >= l_header[1],
+								  EcsInvalidSnapshot);
+	size_  = l_header[0];
+	slots_ = l_header[1];
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Add(const entity_id_t id, Component&& component,
+															   const tick_t tick, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (Contains(id))
+	{
+		RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+	}
+
+	Bind(id, Acquire(component), tick);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Bind(const entity_id_t id, const index_t value,
+																const tick_t tick)
+{
+	ASSERT(dcursor_ < INVALID_INDEX);
+	const uint64_t l_slot = dcursor_++;
+	if (PagedArray<index_t>::OffsetOf(l_slot) == 0)
+	{
+		dvalue_.AssurePage(PagedArray<index_t>::PageOf(l_slot));
+		dentity_.AssurePage(PagedArray<entity_id_t>::PageOf(l_slot));
+		added_.AssurePage(PagedArray<tick_t>::PageOf(l_slot));
+		changed_.AssurePage(PagedArray<tick_t>::PageOf(l_slot));
+	}
+	eindex_.AssurePage(PagedArray<index_t>::PageOf(id), INVALID_INDEX);
+	eindex_[id]		 = static_cast<index_t>(l_slot);
+	dvalue_[l_slot]	 = value;
+	dentity_[l_slot] = id;
+	added_[l_slot]	 = tick;
+	changed_[l_slot] = tick;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!Contains(id))
+	{
+		RESULT_ERROR(EcsComponentDataNotAdded);
+	}
+	const uint64_t l_slot = eindex_[id];
+	eindex_[id]			  = INVALID_INDEX;
+	Release(dvalue_[l_slot]);
+
+	// Swap and pop, the last slot fills the hole
+	const uint64_t l_last = --dcursor_;
+	if (l_slot != l_last)
+	{
+		const entity_id_t l_last_entity = dentity_[l_last];
+		dvalue_[l_slot]					= dvalue_[l_last];
+		dentity_[l_slot]				= l_last_entity;
+		added_[l_slot]					= added_[l_last];
+		changed_[l_slot]				= changed_[l_last];
+		eindex_[l_last_entity]			= static_cast<index_t>(l_slot);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::AddMany(const eastl::span<const entity_id_t> ids,
+																   const eastl::span<Component>		components,
+																   const tick_t tick, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (ids.size() != components.size())
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+	for (const entity_id_t l_id : ids)
+	{
+		if (Contains(l_id))
+		{
+			RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+		}
+	}
+	for (uint64_t l_index = 0; l_index < ids.size(); ++l_index)
+	{
+		Add(ids[l_index], eastl::move(components[l_index]), tick);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::AddCopies(const eastl::span<const entity_id_t> ids,
+																	 const entity_id_t source, const tick_t tick)
+{
+	const index_t l_value = dvalue_[eindex_[source]];
+	ASSERT(values_[l_value].refs + ids.size() < INVALID_INDEX);
+	values_[l_value].refs += static_cast<index_t>(ids.size());
+	for (const entity_id_t l_id : ids)
+	{
+		Bind(l_id, l_value, tick);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SharedComponentArray<Component>::Each(Function&& function)
+{
+	EachRange(0, dcursor_, eastl::forward<Function>(function));
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SharedComponentArray<Component>::EachRange(const uint64_t begin, uint64_t end,
+																	 Function&& function)
+{
+	// Reads go through the const table, so frozen pages are only copied when a value changes
+	const PagedArray<Value>& l_values = values_;
+	end								  = eastl::min(end, dcursor_);
+	for (uint64_t l_slot = begin; l_slot < end; ++l_slot)
+	{
+		Component l_component = l_values[dvalue_[l_slot]].value;
+		function(dentity_[l_slot], l_component);
+		Assign(l_slot, l_component);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SharedComponentArray<Component>::EachEntityRange(const uint64_t begin, uint64_t end,
+																		   Function&& function) const
+{
+	end = eastl::min(end, dcursor_);
+	for (uint64_t l_slot = begin; l_slot < end; ++l_slot)
+	{
+		function(dentity_[l_slot]);
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+template<bool Added, typename Function>
+void Registry<TypeList>::SharedComponentArray<Component>::EachSince(const tick_t since, Function&& function)
+{
+	const PagedArray<Value>&  l_values = values_;
+	const PagedArray<tick_t>& l_ticks  = Added ? added_ : changed_;
+	for (uint64_t l_slot = 0; l_slot < dcursor_; ++l_slot)
+	{
+		if (l_ticks[l_slot] > since)
+		{
+			Component l_component = l_values[dvalue_[l_slot]].value;
+			function(dentity_[l_slot], l_component);
+			Assign(l_slot, l_component);
+		}
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename Function>
+void Registry<TypeList>::SharedComponentArray<Component>::EachValue(Function&& function) const
+{
+	// Counting sort of the slots by value index, the entities of a value keep the slot order
+	eastl::vector<uint64_t> l_offsets(vcursor_ + 1, 0);
+	for (uint64_t l_slot = 0; l_slot < dcursor_; ++l_slot)
+	{
+		++l_offsets[dvalue_[l_slot] + 1];
+	}
+	for (uint64_t l_value = 1; l_value < l_offsets.size(); ++l_value)
+	{
+		l_offsets[l_value] += l_offsets[l_value - 1];
+	}
+	eastl::vector<entity_id_t> l_entities(dcursor_);
+	eastl::vector<uint64_t>	   l_next(l_offsets.begin(), l_offsets.end() - 1);
+	for (uint64_t l_slot = 0; l_slot < dcursor_; ++l_slot)
+	{
+		l_entities[l_next[dvalue_[l_slot]]++] = dentity_[l_slot];
+	}
+
+	for (uint64_t l_value = 0; l_value < vcursor_; ++l_value)
+	{
+		const uint64_t l_count = l_offsets[l_value + 1] - l_offsets[l_value];
+		if (l_count > 0)
+		{
+			function(values_[l_value].value,
+					 eastl::span<const entity_id_t>{l_entities.data() + l_offsets[l_value], l_count});
+		}
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+const Component& Registry<TypeList>::SharedComponentArray<Component>::Load(const entity_id_t id) const
+{
+	return values_[dvalue_[eindex_[id]]].value;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Store(const entity_id_t id, const Component& component)
+{
+	Assign(eindex_[id], component);
+}
+
+template<typename TypeList>
+template<typename Component>
+tick_t* Registry<TypeList>::SharedComponentArray<Component>::ChangedTick(const entity_id_t id)
+{
+	const index_t* l_index = eindex_.TryGet(id);
+	if (!l_index || *l_index == INVALID_INDEX)
+	{
+		return nullptr;
+	}
+	return &changed_[*l_index];
+}
+
+template<typename TypeList>
+template<typename Component>
+bool Registry<TypeList>::SharedComponentArray<Component>::Contains(const entity_id_t id) const
+{
+	const index_t* l_index = eindex_.TryGet(id);
+	return l_index && *l_index != INVALID_INDEX;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::SharedComponentArray<Component>::Size() const
+{
+	return dcursor_;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::SharedComponentArray<Component>::Slots() const
+{
+	return dcursor_;
+}
+
+template<typename TypeList>
+template<typename Component>
+uint64_t Registry<TypeList>::SharedComponentArray<Component>::ValueCount() const
+{
+	return vsize_;
+}
+
+template<typename TypeList>
+template<typename Component>
+ComponentStats Registry<TypeList>::SharedComponentArray<Component>::Stats() const
+{
+	// Slots are dense, the holes are the released values waiting on the free list
+	const uint64_t l_free = vcursor_ - vsize_;
+	return ComponentStats{true,
+						  dentity_.Capacity(),
+						  dcursor_,
+						  l_free,
+						  values_.Bytes(),
+						  dvalue_.Bytes() + dentity_.Bytes() + eindex_.Bytes(),
+						  added_.Bytes() + changed_.Bytes(),
+						  vcursor_ ? static_cast<float32_t>(l_free) / static_cast<float32_t>(vcursor_) : 0.f};
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SharedComponentArray<Component>::Write(StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[4] = {dcursor_, vcursor_, vsize_, vfree_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(values_.Save(stream, vcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(eindex_.Save(stream, eindex_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dvalue_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.Save(stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SharedComponentArray<Component>::Read(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_header[4]{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS), StreamFailedToRead);
+	RESULT_CONDITION_ENSURE_NOLOG(l_header[0] < INVALID_INDEX && l_header[1] < INVALID_INDEX &&
+									  l_header[2] <= l_header[1],
+								  EcsInvalidSnapshot);
+	RESULT_ENSURE_CALL_NOLOG(values_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(eindex_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dvalue_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.Load(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.Load(stream, RESULT_ARG_PASS));
+	RESULT_CONDITION_ENSURE_NOLOG(values_.Capacity() >= l_header[1] && dvalue_.Capacity() >= l_header[0] &&
+									  dentity_.Capacity() >= l_header[0] && changed_.Capacity() >= l_header[0],
+								  EcsInvalidSnapshot);
+	dcursor_ = l_header[0];
+	vcursor_ = l_header[1];
+	vsize_	 = l_header[2];
+	vfree_	 = l_header[3];
+	RebuildBuckets();
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Freeze(SharedComponentArray& frozen)
+{
+	frozen.dcursor_	 = dcursor_;
+	frozen.vcursor_	 = vcursor_;
+	frozen.vsize_	 = vsize_;
+	frozen.vfree_	 = vfree_;
+	frozen.buckets_	 = buckets_;
+	frozen.values_	 = values_.Share();
+	frozen.dvalue_	 = dvalue_.Share();
+	frozen.dentity_	 = dentity_.Share();
+	frozen.eindex_	 = eindex_.Share();
+	frozen.added_	 = added_.Share();
+	frozen.changed_	 = changed_.Share();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Unshare()
+{
+	values_.UnshareAll();
+	dvalue_.UnshareAll();
+	dentity_.UnshareAll();
+	eindex_.UnshareAll();
+	added_.UnshareAll();
+	changed_.UnshareAll();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SharedComponentArray<Component>::WriteDelta(const SharedComponentArray& baseline,
+																	  StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[4] = {dcursor_, vcursor_, vsize_, vfree_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(values_.SaveDelta(baseline.values_, stream, vcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(eindex_.SaveDelta(baseline.eindex_, stream, eindex_.Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dvalue_.SaveDelta(baseline.dvalue_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.SaveDelta(baseline.dentity_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.SaveDelta(baseline.added_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.SaveDelta(baseline.changed_, stream, dcursor_, RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+template<typename StreamType>
+void Registry<TypeList>::SharedComponentArray<Component>::ReadDelta(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	uint64_t l_header[4]{};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS), StreamFailedToRead);
+	RESULT_CONDITION_ENSURE_NOLOG(l_header[0] < INVALID_INDEX && l_header[1] < INVALID_INDEX &&
+									  l_header[2] <= l_header[1],
+								  EcsInvalidSnapshot);
+	RESULT_ENSURE_CALL_NOLOG(values_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(eindex_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dvalue_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(dentity_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(added_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(changed_.LoadDelta(stream, RESULT_ARG_PASS));
+	RESULT_CONDITION_ENSURE_NOLOG(values_.Capacity() >= l_header[1] && dvalue_.Capacity() >= l_header[0] &&
+									  dentity_.Capacity() >= l_header[0] && changed_.Capacity() >= l_header[0],
+								  EcsInvalidSnapshot);
+	dcursor_ = l_header[0];
+	vcursor_ = l_header[1];
+	vsize_	 = l_header[2];
+	vfree_	 = l_header[3];
+	RebuildBuckets();
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+typename Registry<TypeList>::template SharedComponentArray<Component>::index_t Registry<
+	TypeList>::SharedComponentArray<Component>::Acquire(const Component& component)
+{
+	const PagedArray<Value>& l_values = values_;
+	const uint64_t			 l_hash	  = traits_t::Hash(component);
+	const auto				 l_bucket = buckets_.find(l_hash);
+	const index_t			 l_head	  = l_bucket != buckets_.end() ? l_bucket->second : INVALID_INDEX;
+	for (index_t l_value = l_head; l_value != INVALID_INDEX; l_value = l_values[l_value].next)
+	{
+		if (traits_t::Equal(l_values[l_value].value, component))
+		{
+			++values_[l_value].refs;
+			return l_value;
+		}
+	}
+
+	// New value, free entries are reused before the table grows
+	index_t l_value = static_cast<index_t>(vfree_);
+	if (l_value != INVALID_INDEX)
+	{
+		vfree_ = l_values[l_value].next;
+	}
+	else
+	{
+		ASSERT(vcursor_ < INVALID_INDEX);
+		l_value = static_cast<index_t>(vcursor_++);
+		if (PagedArray<Value>::OffsetOf(l_value) == 0)
+		{
+			values_.AssurePage(PagedArray<Value>::PageOf(l_value));
+		}
+	}
+	values_[l_value] = Value{component, 1, l_head};
+	buckets_[l_hash] = l_value;
+	++vsize_;
+	return l_value;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Release(const index_t value)
+{
+	Value& l_entry = values_[value];
+	ASSERT(l_entry.refs > 0);
+	if (--l_entry.refs > 0)
+	{
+		return;
+	}
+
+	// Unlink the value from its collision chain and thread it onto the free list
+	const auto l_bucket = buckets_.find(traits_t::Hash(l_entry.value));
+	ASSERT(l_bucket != buckets_.end());
+	if (l_bucket->second == value)
+	{
+		if (l_entry.next == INVALID_INDEX)
+		{
+			buckets_.erase(l_bucket);
+		}
+		else
+		{
+			l_bucket->second = l_entry.next;
+		}
+	}
+	else
+	{
+		index_t l_previous = l_bucket->second;
+		while (values_[l_previous].next != value)
+		{
+			l_previous = values_[l_previous].next;
+		}
+		values_[l_previous].next = l_entry.next;
+	}
+	l_entry.next = static_cast<index_t>(vfree_);
+	vfree_		 = value;
+	--vsize_;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::Assign(const uint64_t slot, const Component& component)
+{
+	const PagedArray<Value>& l_values = values_;
+	const index_t			 l_old	  = dvalue_[slot];
+	if (traits_t::Equal(l_values[l_old].value, component))
+	{
+		return;
+	}
+	dvalue_[slot] = Acquire(component);
+	Release(l_old);
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::SharedComponentArray<Component>::RebuildBuckets()
+{
+	// Free entries keep their free list link, live entries are chained again
+	buckets_.clear();
+	for (index_t l_value = 0; l_value < vcursor_; ++l_value)
+	{
+		Value& l_entry = values_[l_value];
+		if (l_entry.refs == 0)
+		{
+			continue;
+		}
+		const uint64_t l_hash	= traits_t::Hash(l_entry.value);
+		const auto	   l_bucket = buckets_.find(l_hash);
+		l_entry.next			= l_bucket != buckets_.end() ? l_bucket->second : INVALID_INDEX;
+		buckets_[l_hash]		= l_value;
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentArrayElement<Component>::ComponentArrayElement() : constructed{false}
+{
+	Memory::ClearMemoryType(&memory);
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArrayElement<Component>::ConstructIfAllowed()
+{
+	if (!constructed)
+	{
+		constructed = true;
+		new (memory.mCharData) ComponentArrayType{};
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentArrayElement<Component>::DestroyIfAllowed()
+{
+	if (constructed)
+	{
+		constructed = false;
+		reinterpret_cast<ComponentArrayType*>(memory.mCharData)->~ComponentArrayType();
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+typename Registry<TypeList>::template ComponentArrayElement<Component>::ComponentArrayType* Registry<
+	TypeList>::ComponentArrayElement<Component>::Get()
+{
+	return reinterpret_cast<ComponentArrayType*>(memory.mCharData);
+}
+
+template<typename TypeList>
+template<typename Component>
+const typename Registry<TypeList>::template ComponentArrayElement<Component>::ComponentArrayType* Registry<
+	TypeList>::ComponentArrayElement<Component>::Get() const
+{
+	return reinterpret_cast<const ComponentArrayType*>(memory.mCharData);
+}
+
+template<typename TypeList>
+template<typename Component>
+constexpr uint64_t Registry<TypeList>::GetComponentId()
+{
+	return TypeTraits::FindTupleType<ComponentArrayElement<Component>, component_map_tuple_t>();
+}
+
+template<typename TypeList>
+template<typename Component>
+typename Registry<TypeList>::template ComponentArrayElement<Component>& Registry<TypeList>::GetComponentArrayElement()
+{
+	return eastl::get<GetComponentId<Component>()>(components_map_);
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::ConstructComponentsMap()
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		using Type = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		new (eastl::addressof(eastl::get<Index>(components_map_))) Type{};
+		ConstructComponentsMap<Index + 1>();
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::MoveComponentsMap(component_map_tuple_t&& map)
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		// Component arrays do not point to themselves, so they are relocated by memory copy
+		auto& l_element = eastl::get<Index>(components_map_);
+		auto& l_other	= eastl::get<Index>(map);
+		l_element.DestroyIfAllowed();
+		l_element.constructed = l_other.constructed;
+		l_element.memory	  = l_other.memory;
+		l_other.constructed	  = false;
+		MoveComponentsMap<Index + 1>(eastl::move(map));
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::DestroyComponentsMap()
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		eastl::get<Index>(components_map_).DestroyIfAllowed();
+		DestroyComponentsMap<Index + 1>();
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::RemoveComponentsMap(const entity_id_t id)
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		if constexpr (!IsTagComponent<typename element_t::ComponentArrayType::component_t>::VALUE)
+		{
+			if (auto& l_element = eastl::get<Index>(components_map_);
+				l_element.constructed && l_element.Get()->Contains(id))
+			{
+				if constexpr (eastl::is_same_v<typename element_t::ComponentArrayType::component_t, HierarchyComponent>)
+				{
+					DetachHierarchy(id);
+				}
+				if (owned_.test(Index))
+				{
+					GroupLeave(GroupOf(Index), id);
+				}
+				l_element.Get()->Remove(id);
+			}
+		}
+		RemoveComponentsMap<Index + 1>(id);
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index, typename StreamType>
+void Registry<TypeList>::SaveComponentsMap(StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+
+		// Tags never construct their array, so they only live in the signatures
+		const auto&	   l_element   = eastl::get<Index>(components_map_);
+		const uint64_t l_header[2] = {sizeof(component_t), l_element.constructed};
+		RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+									  StreamFailedToWrite);
+		if constexpr (!IsTagComponent<component_t>::VALUE)
+		{
+			if (l_element.constructed)
+			{
+				RESULT_ENSURE_CALL_NOLOG(l_element.Get()->Write(stream, RESULT_ARG_PASS));
+			}
+		}
+		SaveComponentsMap<Index + 1>(stream, RESULT_ARG_PASS);
+	}
+	else
+	{
+		RESULT_OK();
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index, typename StreamType>
+void Registry<TypeList>::LoadComponentsMap(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+
+		uint64_t l_header[2]{};
+		RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+									  StreamFailedToRead);
+		RESULT_CONDITION_ENSURE_NOLOG(l_header[0] == sizeof(component_t), EcsInvalidSnapshot);
+		if constexpr (!IsTagComponent<component_t>::VALUE)
+		{
+			if (l_header[1])
+			{
+				auto& l_element = eastl::get<Index>(components_map_);
+				l_element.ConstructIfAllowed();
+				RESULT_ENSURE_CALL_NOLOG(l_element.Get()->Read(stream, RESULT_ARG_PASS));
+			}
+		}
+		else
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(!l_header[1], EcsInvalidSnapshot);
+		}
+		LoadComponentsMap<Index + 1>(stream, RESULT_ARG_PASS);
+	}
+	else
+	{
+		RESULT_OK();
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::FreezeComponentsMap(Registry& frozen)
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		if constexpr (!IsTagComponent<typename element_t::ComponentArrayType::component_t>::VALUE)
+		{
+			if (auto& l_element = eastl::get<Index>(components_map_); l_element.constructed)
+			{
+				auto& l_frozen = eastl::get<Index>(frozen.components_map_);
+				l_frozen.ConstructIfAllowed();
+				l_element.Get()->Freeze(*l_frozen.Get());
+			}
+		}
+		FreezeComponentsMap<Index + 1>(frozen);
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::StatsComponentsMap(RegistryStats& stats) const
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		const auto& l_element	  = eastl::get<Index>(components_map_);
+		stats.components[Index] = l_element.constructed ? l_element.Get()->Stats() : ComponentStats{};
+		stats.total_bytes += stats.components[Index].data_bytes + stats.components[Index].index_bytes +
+							 stats.components[Index].tick_bytes;
+		StatsComponentsMap<Index + 1>(stats);
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::UnshareComponentsMap(const signature_t& mask)
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		if constexpr (!IsTagComponent<typename element_t::ComponentArrayType::component_t>::VALUE)
+		{
+			if (auto& l_element = eastl::get<Index>(components_map_); mask.test(Index) && l_element.constructed)
+			{
+				l_element.Get()->Unshare();
+			}
+		}
+		UnshareComponentsMap<Index + 1>(mask);
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+bool Registry<TypeList>::CopyableComponentsMap(const entity_id_t id)
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+		if constexpr (!IsTagComponent<component_t>::VALUE && !eastl::is_copy_constructible_v<component_t>)
+		{
+			if (auto& l_element = eastl::get<Index>(components_map_);
+				l_element.constructed && l_element.Get()->Contains(id))
+			{
+				return false;
+			}
+		}
+		return CopyableComponentsMap<Index + 1>(id);
+	}
+	else
+	{
+		return true;
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index>
+void Registry<TypeList>::InstantiateComponentsMap(const entity_id_t prefab, const eastl::span<const entity_id_t> ids)
+{
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+		if constexpr (!IsTagComponent<component_t>::VALUE && eastl::is_copy_constructible_v<component_t>)
+		{
+			if (auto& l_element = eastl::get<Index>(components_map_);
+				l_element.constructed && l_element.Get()->Contains(prefab))
+			{
+				// Parents are attached one by one to keep the depth-first order
+				if constexpr (eastl::is_same_v<component_t, HierarchyComponent>)
+				{
+					const entity_id_t l_parent = l_element.Get()->Get(prefab)->parent;
+					for (const entity_id_t l_id : ids)
+					{
+						HierarchyComponent l_node{};
+						l_node.parent = l_parent;
+						Add(l_id, eastl::move(l_node));
+					}
+				}
+				else
+				{
+					l_element.Get()->AddCopies(ids, prefab, tick_);
+				}
+			}
+		}
+		InstantiateComponentsMap<Index + 1>(prefab, ids);
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index, typename StreamType>
+void Registry<TypeList>::SaveDeltaComponentsMap(const Registry& baseline, StreamType& stream,
+												RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+
+		const auto&	   l_element   = eastl::get<Index>(components_map_);
+		const auto&	   l_baseline  = eastl::get<Index>(baseline.components_map_);
+		const uint64_t l_header[3] = {sizeof(component_t), l_element.constructed, l_baseline.constructed};
+		RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+									  StreamFailedToWrite);
+		// Components that are not trivially copyable have no raw pages to compare, they are written whole
+		constexpr bool l_whole = !IsSoaComponent<component_t>::VALUE && !eastl::is_trivially_copyable_v<component_t>;
+		if constexpr (!IsTagComponent<component_t>::VALUE)
+		{
+			if (!l_whole && l_element.constructed && l_baseline.constructed)
+			{
+				if constexpr (!l_whole)
+				{
+					RESULT_ENSURE_CALL_NOLOG(l_element.Get()->WriteDelta(*l_baseline.Get(), stream, RESULT_ARG_PASS));
+				}
+			}
+			else if (l_element.constructed)
+			{
+				RESULT_ENSURE_CALL_NOLOG(l_element.Get()->Write(stream, RESULT_ARG_PASS));
+			}
+		}
+		SaveDeltaComponentsMap<Index + 1>(baseline, stream, RESULT_ARG_PASS);
+	}
+	else
+	{
+		RESULT_OK();
+	}
+}
+
+template<typename TypeList>
+template<uint64_t Index, typename StreamType>
+void Registry<TypeList>::LoadDeltaComponentsMap(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if constexpr (Index < components_t::SIZE)
+	{
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+
+		uint64_t l_header[3]{};
+		RESULT_CONDITION_ENSURE_NOLOG(stream.ReadGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+									  StreamFailedToRead);
+		RESULT_CONDITION_ENSURE_NOLOG(l_header[0] == sizeof(component_t), EcsInvalidSnapshot);
+		constexpr bool l_whole = !IsSoaComponent<component_t>::VALUE && !eastl::is_trivially_copyable_v<component_t>;
+		if constexpr (!IsTagComponent<component_t>::VALUE)
+		{
+			auto& l_element = eastl::get<Index>(components_map_);
+			RESULT_CONDITION_ENSURE_NOLOG(l_element.constructed == (l_header[2] != 0), EcsInvalidSnapshot);
+			if (!l_whole && l_header[1] && l_header[2])
+			{
+				if constexpr (!l_whole)
+				{
+					RESULT_ENSURE_CALL_NOLOG(l_element.Get()->ReadDelta(stream, RESULT_ARG_PASS));
+				}
+			}
+			else if (l_header[1])
+			{
+				l_element.DestroyIfAllowed();
+				l_element.ConstructIfAllowed();
+				RESULT_ENSURE_CALL_NOLOG(l_element.Get()->Read(stream, RESULT_ARG_PASS));
+			}
+			else
+			{
+				l_element.DestroyIfAllowed();
+			}
+		}
+		else
+		{
+			RESULT_CONDITION_ENSURE_NOLOG(!l_header[1], EcsInvalidSnapshot);
+		}
+		LoadDeltaComponentsMap<Index + 1>(stream, RESULT_ARG_PASS);
+	}
+	else
+	{
+		RESULT_OK();
+	}
+}
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::ComponentPtr(Registry* registry, Ptr<Component> component,
+														  tick_t* changed)
+	: registry_{registry}, component_{eastl::move(component)}, changed_{changed}
+{
+}
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::ComponentPtr(ComponentPtr&&) noexcept = default;
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::ComponentPtr(const ComponentPtr&) = default;
+template<typename TypeList>
+template<typename Component>
+typename Registry<TypeList>::template ComponentPtr<Component>& Registry<TypeList>::ComponentPtr<Component>::operator=(
+	ComponentPtr&&) noexcept = default;
+template<typename TypeList>
+template<typename Component>
+typename Registry<TypeList>::template ComponentPtr<Component>& Registry<TypeList>::ComponentPtr<Component>::operator=(
+	const ComponentPtr&) = default;
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::~ComponentPtr() = default;
+
+template<typename TypeList>
+template<typename Component>
+auto& Registry<TypeList>::ComponentPtr<Component>::operator->()
+{
+	Touch();
+	return component_;
+}
+
+template<typename TypeList>
+template<typename Component>
+auto& Registry<TypeList>::ComponentPtr<Component>::operator->() const
+{
+	return component_;
+}
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::operator Component*()
+{
+	Touch();
+	return component_;
+}
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::operator Component*() const
+{
+	return component_;
+}
+
+template<typename TypeList>
+template<typename Component>
+Registry<TypeList>::ComponentPtr<Component>::operator bool() const
+{
+	return component_;
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::ComponentPtr<Component>::Touch()
+{
+	if (changed_)
+	{
+		*changed_ = registry_->tick_;
+	}
+}
+
+template<typename TypeList>
+Registry<TypeList>::Registry(const uint64_t capacity, RESULT_PARAM_IMPL)
+{
+	ValidateComponentTuple<typename TypeTraits::TlToTuple<TypeList>::type_t>();
+
+	ConstructComponentsMap<0>();
+	Reserve(capacity);
+}
+
+template<typename TypeList>
+Registry<TypeList>::Registry(Registry&& other) noexcept
+	: tick_{other.tick_}, ecursor_{other.ecursor_.load()}, entities_{eastl::move(other.entities_)},
+	  positions_{eastl::move(other.positions_)}, signatures_{eastl::move(other.signatures_)}, generations_{eastl::move(other.generations_)},
+	  groups_{eastl::move(other.groups_)}, owned_{other.owned_}, queries_{eastl::move(other.queries_)}
+{
+	ConstructComponentsMap<0>();
+	MoveComponentsMap<0>(eastl::move(other.components_map_));
+	other.ecursor_ = 0;
+	other.owned_.reset();
+}
+
+template<typename TypeList>
+Registry<TypeList>& Registry<TypeList>::operator=(Registry&& other) noexcept
+{
+	MoveComponentsMap<0>(eastl::move(other.components_map_));
+
+	tick_		 = other.tick_;
+	ecursor_	 = other.ecursor_.load();
+	entities_	 = eastl::move(other.entities_);
+	positions_	 = eastl::move(other.positions_);
+	signatures_	 = eastl::move(other.signatures_);
+	generations_ = eastl::move(other.generations_);
+	groups_		 = eastl::move(other.groups_);
+	owned_		 = other.owned_;
+	queries_	 = eastl::move(other.queries_);
+
+	other.ecursor_ = 0;
+	other.owned_.reset();
+	return *this;
+}
+
+template<typename TypeList>
+Registry<TypeList>::~Registry()
+{
+	DestroyComponentsMap<0>();
+}
+
+template<typename TypeList>
+entity_id_t Registry<TypeList>::Create(RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG(INVALID_ENTITY_ID);
+	// Only CreateConcurrent runs concurrently, so the cursor is plainly loaded and stored here
+	const uint64_t l_cursor = ecursor_.load(eastl::memory_order_relaxed);
+	if (l_cursor == Capacity())
+	{
+		GrowEntities();
+	}
+	const auto l_id = entities_[l_cursor];
+	ecursor_.store(l_cursor + 1, eastl::memory_order_relaxed);
+	new (&signatures_[l_id]) signature_t{};
+	RESULT_OK();
+	return l_id;
+}
+
+template<typename TypeList>
+void Registry<TypeList>::Destroy(entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (!IsLive(id))
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+	const uint64_t l_cursor = ecursor_.load(eastl::memory_order_relaxed);
+	ReleaseEntity(id, l_cursor - 1);
+	ecursor_.store(l_cursor - 1, eastl::memory_order_relaxed);
+	const signature_t l_before = signatures_[id];
+	signatures_[id].reset();
+	QueryUpdate(id, l_before);
+	++generations_[id];
+	RemoveComponentsMap<0>(id);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+entity_id_t Registry<TypeList>::CreateConcurrent(RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG(INVALID_ENTITY_ID);
+	const uint64_t l_capacity = Capacity();
+	uint64_t	   l_cursor	  = ecursor_.load(eastl::memory_order_relaxed);
+	do
+	{
+		if (l_cursor == l_capacity)
+		{
+			RESULT_ERROR(EcsNoEntityAvailable, INVALID_ENTITY_ID);
+		}
+	} while (!ecursor_.compare_exchange_weak(l_cursor, l_cursor + 1, eastl::memory_order_relaxed));
+
+	// The free stack is only read, so frozen pages are never copied here. Free ids already hold an empty signature,
+	// Destroy resets it and new pages are filled empty.
+	const PagedArray<entity_id_t>& l_entities = entities_;
+	RESULT_OK();
+	return l_entities[l_cursor];
+}
+
+template<typename TypeList>
+EntityHandle Registry<TypeList>::Handle(const entity_id_t id, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG((EntityHandle{INVALID_ENTITY_ID, 0}));
+	if (!IsLive(id))
+	{
+		RESULT_ERROR(EcsInvalidEntityId, (EntityHandle{INVALID_ENTITY_ID, 0}));
+	}
+	RESULT_OK();
+	return EntityHandle{id, generations_[id]};
+}
+
+template<typename TypeList>
+bool Registry<TypeList>::IsAlive(const EntityHandle& handle, RESULT_PARAM_IMPL) const
+{
+	return IsLive(handle.id) && generations_[handle.id] == handle.generation;
+}
+
+template<typename TypeList>
+void Registry<TypeList>::CreateMany(const uint64_t count, const eastl::span<entity_id_t> ids, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (ids.size() < count)
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+	uint64_t l_cursor = ecursor_.load(eastl::memory_order_relaxed);
+	Reserve(l_cursor + count);
+
+	constexpr uint64_t l_page_size = PagedArray<entity_id_t>::PAGE_SIZE;
+	for (uint64_t l_done = 0; l_done < count;)
+	{
+		const uint64_t			 l_offset = PagedArray<entity_id_t>::OffsetOf(l_cursor);
+		const uint64_t			 l_chunk  = eastl::min(l_page_size - l_offset, count - l_done);
+		const entity_id_t* const l_source = entities_.Page(PagedArray<entity_id_t>::PageOf(l_cursor)) + l_offset;
+
+		memcpy(ids.data() + l_done, l_source, l_chunk * sizeof(entity_id_t));
+		for (uint64_t l_index = 0; l_index < l_chunk; ++l_index)
+		{
+			new (&signatures_[l_source[l_index]]) signature_t{};
+		}
+
+		l_cursor += l_chunk;
+		l_done += l_chunk;
+	}
+	ecursor_.store(l_cursor, eastl::memory_order_relaxed);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+void Registry<TypeList>::Instantiate(const entity_id_t prefab, const uint64_t count, const eastl::span<entity_id_t> ids,
+									 RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (prefab >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+	if (ids.size() < count)
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+	if (!CopyableComponentsMap<0>(prefab))
+	{
+		RESULT_ERROR(EcsComponentNotCopyable);
+	}
+
+	const signature_t l_signature = signatures_[prefab];
+	RESULT_ENSURE_CALL_NOLOG(CreateMany(count, ids, RESULT_ARG_PASS));
+	const eastl::span<const entity_id_t> l_ids{ids.data(), count};
+	InstantiateComponentsMap<0>(prefab, l_ids);
+
+	for (GroupState& l_group : groups_)
+	{
+		for (const entity_id_t l_id : l_ids)
+		{
+			GroupEnter(l_group, l_id);
+		}
+	}
+
+	for (const entity_id_t l_id : l_ids)
+	{
+		const signature_t l_before = signatures_[l_id];
+		signatures_[l_id]		   = l_signature;
+		QueryUpdate(l_id, l_before);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+void Registry<TypeList>::DestroyMany(const eastl::span<const entity_id_t> ids, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (ids.size() > ecursor_)
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+
+	// Live ids have distinct positions below the cursor, so duplicates are found by marking the positions
+	const PagedArray<entity_id_t>& l_positions = positions_;
+	eastl::bitvector<>			   l_seen(ecursor_.load(eastl::memory_order_relaxed), false);
+	for (const entity_id_t l_id : ids)
+	{
+		if (!IsLive(l_id) || l_seen[l_positions[l_id]])
+		{
+			RESULT_ERROR(EcsInvalidEntityId);
+		}
+		l_seen[l_positions[l_id]] = true;
+	}
+
+	uint64_t l_cursor = ecursor_.load(eastl::memory_order_relaxed);
+	for (const entity_id_t l_id : ids)
+	{
+		ReleaseEntity(l_id, --l_cursor);
+		const signature_t l_before = signatures_[l_id];
+		signatures_[l_id].reset();
+		QueryUpdate(l_id, l_before);
+		++generations_[l_id];
+		RemoveComponentsMap<0>(l_id);
+	}
+	ecursor_.store(l_cursor, eastl::memory_order_relaxed);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename StreamType>
+void Registry<TypeList>::Save(StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[3] = {components_t::SIZE, ecursor_, tick_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(entities_.Save(stream, Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(signatures_.Save(stream, Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(generations_.Save(stream, Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(SaveComponentsMap<0>(stream, RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename StreamType>
+void Registry<TypeList>::Load(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	Clear();
+
+	// Errors are tracked locally, a partial load is never kept even when the caller passes no result
+	RESULT_VALUE_VAR(l_result);
+	uint64_t l_header[3]{};
+	if (!stream.ReadGeneric(l_header, sizeof l_header, &l_result))
+	{
+		RESULT_ERROR(StreamFailedToRead);
+	}
+	if (l_header[0] != components_t::SIZE)
+	{
+		RESULT_ERROR(EcsInvalidSnapshot);
+	}
+	entities_.Load(stream, &l_result);
+	signatures_.Load(stream, &l_result);
+	generations_.Load(stream, &l_result);
+	if (l_result == Ok && (entities_.Capacity() != signatures_.Capacity() ||
+						   entities_.Capacity() != generations_.Capacity() || l_header[1] > Capacity() ||
+						   !RebuildPositions()))
+	{
+		l_result = EcsInvalidSnapshot;
+	}
+	LoadComponentsMap<0>(stream, &l_result);
+	if (l_result != Ok)
+	{
+		Clear();
+		RESULT_ERROR(l_result);
+	}
+	ecursor_ = l_header[1];
+	tick_	 = static_cast<tick_t>(l_header[2]);
+	RebuildGroups();
+	RebuildQueries();
+	RESULT_OK();
+}
+
+template<typename TypeList>
+Registry<TypeList> Registry<TypeList>::Freeze(RESULT_PARAM_IMPL)
+{
+	Registry l_frozen{0};
+	RESULT_ENSURE_LAST_NOLOG(l_frozen);
+	l_frozen.tick_		 = tick_;
+	l_frozen.ecursor_	  = ecursor_.load();
+	l_frozen.entities_	  = entities_.Share();
+	l_frozen.positions_	  = positions_.Share();
+	l_frozen.signatures_  = signatures_.Share();
+	l_frozen.generations_ = generations_.Share();
+	l_frozen.groups_	  = groups_;
+	l_frozen.owned_		  = owned_;
+	FreezeComponentsMap<0>(l_frozen);
+	RESULT_OK();
+	return l_frozen;
+}
+
+template<typename TypeList>
+void Registry<TypeList>::Unshare(const signature_t& mask, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	signatures_.UnshareAll();
+	UnshareComponentsMap<0>(mask);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename StreamType>
+void Registry<TypeList>::SaveDelta(const Registry& baseline, StreamType& stream, RESULT_PARAM_IMPL) const
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_header[5] = {components_t::SIZE, baseline.ecursor_, baseline.tick_, ecursor_, tick_};
+	RESULT_CONDITION_ENSURE_NOLOG(stream.WriteGeneric(l_header, sizeof l_header, RESULT_ARG_PASS),
+								  StreamFailedToWrite);
+	RESULT_ENSURE_CALL_NOLOG(entities_.SaveDelta(baseline.entities_, stream, Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(signatures_.SaveDelta(baseline.signatures_, stream, Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(generations_.SaveDelta(baseline.generations_, stream, Capacity(), RESULT_ARG_PASS));
+	RESULT_ENSURE_CALL_NOLOG(SaveDeltaComponentsMap<0>(baseline, stream, RESULT_ARG_PASS));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename StreamType>
+void Registry<TypeList>::LoadDelta(StreamType& stream, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+
+	// The entity cursor and tick of the baseline catch most deltas applied to the wrong state
+	RESULT_VALUE_VAR(l_result);
+	uint64_t l_header[5]{};
+	if (!stream.ReadGeneric(l_header, sizeof l_header, &l_result))
+	{
+		RESULT_ERROR(StreamFailedToRead);
+	}
+	if (l_header[0] != components_t::SIZE || l_header[1] != ecursor_ || l_header[2] != tick_)
+	{
+		RESULT_ERROR(EcsInvalidSnapshot);
+	}
+	entities_.LoadDelta(stream, &l_result);
+	signatures_.LoadDelta(stream, &l_result);
+	generations_.LoadDelta(stream, &l_result);
+	if (l_result == Ok && (entities_.Capacity() != signatures_.Capacity() ||
+						   entities_.Capacity() != generations_.Capacity() || l_header[3] > Capacity() ||
+						   !RebuildPositions()))
+	{
+		l_result = EcsInvalidSnapshot;
+	}
+	LoadDeltaComponentsMap<0>(stream, &l_result);
+	if (l_result != Ok)
+	{
+		Clear();
+		RESULT_ERROR(l_result);
+	}
+	ecursor_ = l_header[3];
+	tick_	 = static_cast<tick_t>(l_header[4]);
+	RebuildGroups();
+	RebuildQueries();
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components>
+void Registry<TypeList>::Enable(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (id >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+	(SetEnabledInternal<Components>(id, true), ...);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components>
+void Registry<TypeList>::Disable(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (id >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+	(SetEnabledInternal<Components>(id, false), ...);
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+bool Registry<TypeList>::IsEnabled(const entity_id_t id, RESULT_PARAM_IMPL) const
+{
+	if (id >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId, false);
+	}
+	RESULT_OK();
+	return signatures_[id].test(GetComponentId<Component>());
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::Add(const entity_id_t id, Component&& component, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (id >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+
+	// Hierarchy components are appended as roots, which keeps the depth-first order, then attached to the parent
+	if constexpr (eastl::is_same_v<Component, HierarchyComponent>)
+	{
+		if (const entity_id_t l_parent = component.parent; l_parent != INVALID_ENTITY_ID)
+		{
+			if (l_parent == id || l_parent >= Capacity())
+			{
+				RESULT_ERROR(EcsInvalidEntityId);
+			}
+			RESULT_ENSURE_CALL_NOLOG(Add(id, HierarchyComponent{}, RESULT_ARG_PASS));
+			RESULT_ENSURE_CALL_NOLOG(SetParent(id, l_parent, RESULT_ARG_PASS));
+			RESULT_OK();
+			return;
+		}
+		component.depth = 0;
+	}
+
+	constexpr uint64_t l_id = GetComponentId<Component>();
+	if constexpr (IsTagComponent<Component>::VALUE)
+	{
+		if (signatures_[id].test(l_id))
+		{
+			RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+		}
+		const signature_t l_before = signatures_[id];
+		signatures_[id].set(l_id);
+		QueryUpdate(id, l_before);
+		RESULT_OK();
+		return;
+	}
+
+	auto& l_component_element = GetComponentArrayElement<Component>();
+
+	// Enable component inline
+	if (!signatures_[id].test(l_id))
+	{
+		const signature_t l_before = signatures_[id];
+		signatures_[id].set(l_id);
+		QueryUpdate(id, l_before);
+		l_component_element.ConstructIfAllowed();
+	}
+
+	// Add component
+	l_component_element.Get()->Add(id, eastl::forward<Component>(component), tick_);
+	if (owned_.test(l_id))
+	{
+		GroupEnter(GroupOf(l_id), id);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (id >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+	constexpr uint64_t l_id = GetComponentId<Component>();
+	if constexpr (IsTagComponent<Component>::VALUE)
+	{
+		if (!signatures_[id].test(l_id))
+		{
+			RESULT_ERROR(EcsComponentDataNotAdded);
+		}
+		const signature_t l_before = signatures_[id];
+		signatures_[id].set(l_id, false);
+		QueryUpdate(id, l_before);
+		RESULT_OK();
+		return;
+	}
+
+	if constexpr (eastl::is_same_v<Component, HierarchyComponent>)
+	{
+		DetachHierarchy(id);
+	}
+	if (owned_.test(l_id))
+	{
+		GroupLeave(GroupOf(l_id), id);
+	}
+	const signature_t l_before = signatures_[id];
+	signatures_[id].set(l_id, false);
+	QueryUpdate(id, l_before);
+	GetComponentArrayElement<Component>().Get()->Remove(id);
+	RESULT_OK();
+}
 
-public:
-	NODISCARD uint64_t Capacity(RESULT_PARAM_DEFINE) const;
-	NODISCARD bool	   Contains(const entity_id_t* ptr, RESULT_PARAM_DEFINE) const;
-	void			   Clear(RESULT_PARAM_DEFINE);
+template<typename TypeList>
+template<typename Component>
+void Registry<TypeList>::AddMany(const eastl::span<const entity_id_t> ids, const eastl::span<Component> components,
+								 RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (ids.size() != components.size())
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+	constexpr uint64_t l_id = GetComponentId<Component>();
+	for (const entity_id_t l_entity : ids)
+	{
+		if (l_entity >= Capacity())
+		{
+			RESULT_ERROR(EcsInvalidEntityId);
+		}
+		// Tags have no array to reject duplicates, so the signature is checked before any bit is set
+		if constexpr (IsTagComponent<Component>::VALUE)
+		{
+			if (signatures_[l_entity].test(l_id))
+			{
+				RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+			}
+		}
+	}
 
-private:
-	template<typename Component>
-	void SetEnabledInternal(entity_id_t id, bool value, RESULT_PARAM_DEFINE);
+	// Parents are attached one by one to keep the depth-first order
+	if constexpr (eastl::is_same_v<Component, HierarchyComponent>)
+	{
+		for (uint64_t l_index = 0; l_index < ids.size(); ++l_index)
+		{
+			RESULT_ENSURE_CALL_NOLOG(Add(ids[l_index], eastl::move(components[l_index]), RESULT_ARG_PASS));
+		}
+		RESULT_OK();
+		return;
+	}
 
-private:
-	entity_id_t *		  ebegin_{}, *eend_{}, *ecursor_{};
-	signature_t*		  signatures_{};
-	component_map_tuple_t components_map_;
-};
+	if constexpr (!IsTagComponent<Component>::VALUE)
+	{
+		auto& l_component_element = GetComponentArrayElement<Component>();
+		l_component_element.ConstructIfAllowed();
+		RESULT_ENSURE_CALL_NOLOG(l_component_element.Get()->AddMany(ids, components, tick_, RESULT_ARG_PASS));
+	}
+
+	if (owned_.test(l_id))
+	{
+		for (const entity_id_t l_entity : ids)
+		{
+			GroupEnter(GroupOf(l_id), l_entity);
+		}
+	}
+
+	for (const entity_id_t l_entity : ids)
+	{
+		const signature_t l_before = signatures_[l_entity];
+		signatures_[l_entity].set(l_id);
+		QueryUpdate(l_entity, l_before);
+	}
+	RESULT_OK();
+}
 
 template<typename TypeList>
 template<typename Component>
-Registry<TypeList>::ComponentArray<Component>::ComponentArray(const uint64_t capacity)
+typename Registry<TypeList>::template ComponentPtr<Component> Registry<TypeList>::Get(const entity_id_t id,
+																					  RESULT_PARAM_IMPL)
 {
-	data_	 = static_cast<Component*>(EASTLAllocatorType("Ecs").allocate(capacity * sizeof(Component)));
-	dcursor_ = data_;
-	eindex_	 = static_cast<uint64_t*>(EASTLAllocatorType("Ecs").allocate(capacity * sizeof(uint64_t)));
-	eastl::uninitialized_fill_n(eindex_, capacity, INVALID_COMPONENT_ID);
-	eindex_end_ = eindex_ + capacity;
+	static_assert(!IsSoaComponent<Component>::VALUE, "SoA components have no address, use Each, View or Streams.");
+	static_assert(!IsSharedComponent<Component>::VALUE,
+				  "Shared components have no address, use Each, View or EachShared.");
+	RESULT_ENSURE_LAST_NOLOG(ComponentPtr<Component>{this, nullptr});
+	if (!IsEnabled<Component>(id))
+	{
+		RESULT_ERROR(EcsComponentNotEnabled, ComponentPtr<Component>{this, nullptr});
+	}
+	RESULT_OK();
+	if constexpr (IsTagComponent<Component>::VALUE)
+	{
+		return ComponentPtr<Component>{this, PTR(GetComponentData<Component>(id))};
+	}
+	else
+	{
+		auto* l_array = GetComponentArrayElement<Component>().Get();
+		return ComponentPtr<Component>{this, PTR(l_array->Get(id)), l_array->ChangedTick(id)};
+	}
 }
 
 template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentArray<Component>::~ComponentArray()
+template<typename Component, typename Function>
+void Registry<TypeList>::Each(Function&& function, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if constexpr (IsTagComponent<Component>::VALUE)
+	{
+		signature_t l_mask{};
+		l_mask.set(GetComponentId<Component>());
+		EachSignature(l_mask, 0, Capacity(), [&](entity_id_t) { function(TagInstance<Component>()); });
+	}
+	else
+	{
+		auto& l_element = GetComponentArrayElement<Component>();
+		if (l_element.constructed)
+		{
+			l_element.Get()->Each([&](entity_id_t, Component& component) { function(component); });
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components, typename Function>
+void Registry<TypeList>::View(Function&& function, RESULT_PARAM_IMPL)
 {
-	const auto l_size = eindex_end_ - eindex_;
+	static_assert(sizeof...(Components) > 0, "View needs at least one component type.");
+	RESULT_ENSURE_LAST_NOLOG();
+	ViewInternal<Components...>(eastl::forward<Function>(function),
+								[](const uint64_t count, uint64_t, auto&& range) { range(0, count); });
+	RESULT_OK();
+}
 
-	EASTLAllocatorType("Ecs").deallocate(data_, l_size * sizeof(Component));
-	data_ = dcursor_ = nullptr;
-	cursor_fl_		 = nullptr;
+template<typename TypeList>
+template<typename Component, typename Function>
+void Registry<TypeList>::ParallelEach(Function&& function, const uint64_t grain, RESULT_PARAM_IMPL)
+{
+	static_assert(!IsSharedComponent<Component>::VALUE, "Storing shared values is not thread safe, use Each.");
+	RESULT_ENSURE_LAST_NOLOG();
+	Unshare(Mask<Component>());
+	if constexpr (IsTagComponent<Component>::VALUE)
+	{
+		signature_t l_mask{};
+		l_mask.set(GetComponentId<Component>());
+		JobPool::Default().ParallelFor(
+			Capacity(), AlignGrain(grain, PagedArray<signature_t>::CACHE_LINE_ELEMENTS),
+			[&](const uint64_t begin, const uint64_t end) {
+				EachSignature(l_mask, begin, end, [&](entity_id_t) { function(TagInstance<Component>()); });
+			});
+	}
+	else
+	{
+		auto& l_element = GetComponentArrayElement<Component>();
+		if (l_element.constructed)
+		{
+			component_array_t<Component>* l_array = l_element.Get();
+			JobPool::Default().ParallelFor(
+				l_array->Slots(), AlignGrain(grain, component_array_t<Component>::CACHE_LINE_ELEMENTS),
+				[&](const uint64_t begin, const uint64_t end) {
+					l_array->EachRange(begin, end, [&](entity_id_t, Component& component) { function(component); });
+				});
+		}
+	}
+	RESULT_OK();
+}
 
-	EASTLAllocatorType("Ecs").deallocate(eindex_, sizeof(uint64_t));
-	eindex_ = eindex_end_ = nullptr;
+template<typename TypeList>
+template<typename... Components, typename Function>
+void Registry<TypeList>::ParallelView(Function&& function, const uint64_t grain, RESULT_PARAM_IMPL)
+{
+	static_assert(sizeof...(Components) > 0, "View needs at least one component type.");
+	static_assert(!(IsSharedComponent<Components>::VALUE || ...), "Storing shared values is not thread safe, use View.");
+	RESULT_ENSURE_LAST_NOLOG();
+	Unshare(Mask<Components...>());
+	ViewInternal<Components...>(eastl::forward<Function>(function),
+								[&](const uint64_t count, const uint64_t step, auto&& range) {
+									JobPool::Default().ParallelFor(count, AlignGrain(grain, step), range);
+								});
+	RESULT_OK();
 }
 
 template<typename TypeList>
 template<typename Component>
-void Registry<TypeList>::ComponentArray<Component>::Add(const entity_id_t id, Component&& component, RESULT_PARAM_IMPL)
+SoaStreams Registry<TypeList>::Streams(const uint64_t page, RESULT_PARAM_IMPL)
 {
+	static_assert(IsSoaComponent<Component>::VALUE, "Streams are only available for SoA components.");
+	RESULT_ENSURE_LAST_NOLOG(SoaStreams{});
+	auto& l_element = GetComponentArrayElement<Component>();
+	RESULT_OK();
+	return l_element.constructed ? l_element.Get()->Streams(page) : SoaStreams{};
+}
+
+template<typename TypeList>
+template<typename Component, typename Function>
+void Registry<TypeList>::EachShared(Function&& function, RESULT_PARAM_IMPL)
+{
+	static_assert(IsSharedComponent<Component>::VALUE, "EachShared is only available for shared components.");
 	RESULT_ENSURE_LAST_NOLOG();
-	if (Contains(id))
+	if (auto& l_element = GetComponentArrayElement<Component>(); l_element.constructed)
 	{
-		RESULT_ERROR(EcsComponentDataAddedMoreThanOnce);
+		l_element.Get()->EachValue(eastl::forward<Function>(function));
 	}
+	RESULT_OK();
+}
 
-	Component* l_target_data;
-	if (!cursor_fl_)
+template<typename TypeList>
+template<typename Component, typename Function>
+void Registry<TypeList>::Sort(Function&& key, RESULT_PARAM_IMPL)
+{
+	using key_t = eastl::decay_t<decltype(key(eastl::declval<const Component&>()))>;
+	static_assert(ComponentStorageOf<Component>::VALUE == ComponentStorage::eDense && !IsTagComponent<Component>::VALUE,
+				  "Only dense components can be sorted.");
+	static_assert(!eastl::is_same_v<Component, HierarchyComponent>, "The hierarchy order is kept by SetParent.");
+	static_assert(eastl::is_unsigned_v<key_t> && (sizeof(key_t) == 4 || sizeof(key_t) == 8),
+				  "Sort keys must be 32 or 64-bit unsigned integers.");
+	RESULT_ENSURE_LAST_NOLOG();
+	if (owned_.test(GetComponentId<Component>()))
 	{
-		l_target_data = reinterpret_cast<Component*>(dcursor_++);
+		RESULT_ERROR(EcsComponentOwnedByGroup);
 	}
-	else
+	auto& l_element = GetComponentArrayElement<Component>();
+	if (!l_element.constructed)
 	{
-		l_target_data = reinterpret_cast<Component*>(cursor_fl_);
-		cursor_fl_	  = cursor_fl_->next;
+		RESULT_OK();
+		return;
 	}
 
-	eindex_[id]	   = l_target_data - data_;
-	*l_target_data = eastl::move(component);
+	auto*				 l_array = l_element.Get();
+	eastl::vector<key_t> l_keys{};
+	l_keys.reserve(l_array->Slots());
+	l_array->Each([&](entity_id_t, const Component& component) { l_keys.push_back(key(component)); });
+	l_array->Permute(Detail::RadixSort(l_keys));
 	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename Component>
-void Registry<TypeList>::ComponentArray<Component>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+template<typename Component, typename Reference>
+void Registry<TypeList>::SortAs(RESULT_PARAM_IMPL)
 {
+	static_assert(ComponentStorageOf<Component>::VALUE == ComponentStorage::eDense && !IsTagComponent<Component>::VALUE,
+				  "Only dense components can be sorted.");
+	static_assert(!eastl::is_same_v<Component, HierarchyComponent>, "The hierarchy order is kept by SetParent.");
+	static_assert(!IsTagComponent<Reference>::VALUE && !IsSoaComponent<Reference>::VALUE,
+				  "The reference component needs a storage order.");
 	RESULT_ENSURE_LAST_NOLOG();
-	if (!Contains(id))
+	if (owned_.test(GetComponentId<Component>()))
 	{
-		RESULT_ERROR(EcsComponentDataNotAdded);
+		RESULT_ERROR(EcsComponentOwnedByGroup);
+	}
+	auto& l_element	  = GetComponentArrayElement<Component>();
+	auto& l_reference = GetComponentArrayElement<Reference>();
+	if (!l_element.constructed || !l_reference.constructed)
+	{
+		RESULT_OK();
+		return;
 	}
-	const auto l_index_removed_entity = eindex_[id];
-	data_[l_index_removed_entity].~Component();
-	eindex_[id] = INVALID_COMPONENT_ID;
 
-	// Add to cursor free list
-	auto l_new_cursor  = reinterpret_cast<CursorFreeList*>(data_ + l_index_removed_entity);
-	l_new_cursor->next = cursor_fl_;
-	cursor_fl_		   = l_new_cursor;
+	// The slot in the reference is the key, entities without reference rank after every slot in the current order
+	auto*					l_array			  = l_element.Get();
+	const auto*				l_reference_array = l_reference.Get();
+	const uint64_t			l_slots			  = l_reference_array->Slots();
+	eastl::vector<uint64_t> l_keys{};
+	l_keys.reserve(l_array->Slots());
+	l_array->Each(
+		[&](const entity_id_t id, const Component&)
+		{
+			l_keys.push_back(l_reference_array->Contains(id) ? l_reference_array->eindex_[id]
+															 : l_slots + l_keys.size());
+		});
+	l_array->Permute(Detail::RadixSort(l_keys));
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components>
+uint64_t Registry<TypeList>::Group(RESULT_PARAM_IMPL)
+{
+	static_assert(sizeof...(Components) > 1, "A group needs at least two component types.");
+	static_assert(((ComponentStorageOf<Components>::VALUE == ComponentStorage::eDense &&
+					!IsTagComponent<Components>::VALUE && !eastl::is_same_v<Components, HierarchyComponent>) &&
+				   ...),
+				  "Only dense components can be owned by a group.");
+	RESULT_ENSURE_LAST_NOLOG(0);
+	signature_t l_mask{};
+	(l_mask.set(GetComponentId<Components>()), ...);
+	ASSERT(l_mask.count() == sizeof...(Components));
+
+	if ((owned_ & l_mask).any())
+	{
+		GroupState& l_group = GroupOf(GetComponentId<eastl::tuple_element_t<0, eastl::tuple<Components...>>>());
+		if (l_group.owned != l_mask)
+		{
+			RESULT_ERROR(EcsComponentOwnedByGroup, 0);
+		}
+		RESULT_OK();
+		return l_group.size;
+	}
 
+	owned_ |= l_mask;
+	groups_.push_back(GroupState{l_mask, 0});
+	GroupState& l_group = groups_.back();
+	FillGroupComponentsMap<0>(l_group);
 	RESULT_OK();
+	return l_group.size;
 }
 
 template<typename TypeList>
-template<typename Component>
-Component* Registry<TypeList>::ComponentArray<Component>::Get(const entity_id_t id)
+template<typename... Components, typename Function>
+void Registry<TypeList>::EachGroup(Function&& function, RESULT_PARAM_IMPL)
 {
-	if (!Contains(id))
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_size = Group<Components...>(RESULT_ARG_PASS);
+	RESULT_ENSURE_LAST_NOLOG();
+
+	// Every owned array holds the group in its first slots, pages of the same index cover the same slots
+	using first_t				   = eastl::tuple_element_t<0, eastl::tuple<Components...>>;
+	constexpr uint64_t l_page_size = PagedArray<first_t>::PAGE_SIZE;
+	static_assert(((PagedArray<Components>::PAGE_SIZE == l_page_size) && ...), "Group pages must be aligned.");
+	for (uint64_t l_begin = 0; l_begin < l_size; l_begin += l_page_size)
 	{
-		return nullptr;
+		const uint64_t					l_page	   = PagedArray<first_t>::PageOf(l_begin);
+		const uint64_t					l_count	   = eastl::min(l_page_size, l_size - l_begin);
+		const entity_id_t* const		l_entities = GetComponentArrayElement<first_t>().Get()->dentity_.Page(l_page);
+		const eastl::tuple<Components*...> l_data{GetComponentArrayElement<Components>().Get()->data_.Page(l_page)...};
+		for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+		{
+			function(l_entities[l_index], eastl::get<Components*>(l_data)[l_index]...);
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components>
+uint64_t Registry<TypeList>::Query(RESULT_PARAM_IMPL)
+{
+	static_assert(sizeof...(Components) > 0, "A query needs at least one component type.");
+	RESULT_ENSURE_LAST_NOLOG(0);
+	const signature_t l_mask  = Mask<Components...>();
+	QueryState*		  l_query = FindQuery(l_mask);
+	if (!l_query)
+	{
+		queries_.push_back(QueryState{l_mask, {}, {}});
+		l_query = &queries_.back();
+		EachSignature(l_mask, 0, Capacity(), [&](const entity_id_t id) { QueryInsert(*l_query, id); });
+	}
+	RESULT_OK();
+	return l_query->entities.size();
+}
+
+template<typename TypeList>
+template<typename... Components, typename Function>
+void Registry<TypeList>::EachQuery(Function&& function, RESULT_PARAM_IMPL)
+{
+	static_assert(sizeof...(Components) > 0, "A query needs at least one component type.");
+	RESULT_ENSURE_LAST_NOLOG();
+	const QueryState* l_query = FindQuery(Mask<Components...>());
+	if (!l_query)
+	{
+		RESULT_ERROR(EcsQueryNotRegistered);
+	}
+
+	// A component that was never added or enabled cannot match any entity
+	if (((IsTagComponent<Components>::VALUE || GetComponentArrayElement<Components>().constructed) && ...))
+	{
+		for (const entity_id_t l_id : l_query->entities)
+		{
+			VisitView<Components...>(l_id, function);
+		}
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components>
+void Registry<TypeList>::ReleaseQuery(RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	signature_t l_mask{};
+	(l_mask.set(GetComponentId<Components>()), ...);
+	if (QueryState* l_query = FindQuery(l_mask))
+	{
+		queries_.erase(queries_.begin() + (l_query - queries_.data()));
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+uint64_t Registry<TypeList>::Filter(const signature_t& required, const signature_t& excluded,
+									const signature_t& optional, const eastl::span<entity_id_t> ids,
+									RESULT_PARAM_IMPL) const
+{
+	static_assert(eastl::is_trivially_copyable_v<signature_t> && sizeof(signature_t) % sizeof(uint64_t) == 0,
+				  "Signatures must be arrays of 64-bit words.");
+	constexpr uint64_t l_words = sizeof(signature_t) / sizeof(uint64_t);
+	RESULT_ENSURE_LAST_NOLOG(0);
+	if (ids.size() < Size())
+	{
+		RESULT_ERROR(EcsInvalidSpanSize, 0);
+	}
+
+	// Free ids have empty signatures, an optional mask with every bit keeps them out
+	const signature_t l_optional = optional.none() ? ~signature_t{} : optional;
+	const auto		  l_words_of = [](const signature_t& signature) {
+		return reinterpret_cast<const uint64_t*>(&signature);
+	};
+
+	constexpr uint64_t l_page_size = PagedArray<signature_t>::PAGE_SIZE;
+	uint64_t		   l_count	   = 0;
+	for (uint64_t l_page = 0; l_page < signatures_.PageCount(); ++l_page)
+	{
+		l_count += Detail::FilterSignatures(l_words_of(*signatures_.Page(l_page)), l_words, l_page_size,
+											l_words_of(required), l_words_of(excluded), l_words_of(l_optional),
+											l_page * l_page_size, ids.data() + l_count);
+	}
+	RESULT_OK();
+	return l_count;
+}
+
+template<typename TypeList>
+template<typename Required, typename Excluded, typename Optional>
+uint64_t Registry<TypeList>::Filter(const eastl::span<entity_id_t> ids, RESULT_PARAM_IMPL) const
+{
+	return Filter(Mask(Required{}), Mask(Excluded{}), Mask(Optional{}), ids, RESULT_ARG_PASS);
+}
+
+template<typename TypeList>
+template<typename... Components>
+typename Registry<TypeList>::signature_t Registry<TypeList>::Mask(TypeTraits::TypeList<Components...>)
+{
+	signature_t l_mask{};
+	(l_mask.set(GetComponentId<Components>()), ...);
+	return l_mask;
+}
+
+template<typename TypeList>
+void Registry<TypeList>::SetParent(const entity_id_t child, const entity_id_t parent, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (child >= Capacity() || child == parent || (parent != INVALID_ENTITY_ID && parent >= Capacity()))
+	{
+		RESULT_ERROR(EcsInvalidEntityId);
+	}
+	auto& l_element = GetComponentArrayElement<HierarchyComponent>();
+	if (!l_element.constructed || !l_element.Get()->Contains(child))
+	{
+		RESULT_ENSURE_CALL_NOLOG(Add(child, HierarchyComponent{}, RESULT_ARG_PASS));
+	}
+	auto* l_array = l_element.Get();
+	if (parent != INVALID_ENTITY_ID && !l_array->Contains(parent))
+	{
+		RESULT_ENSURE_CALL_NOLOG(Add(parent, HierarchyComponent{}, RESULT_ARG_PASS));
+	}
+
+	const uint64_t l_first = l_array->eindex_[child];
+	if (l_array->data_[l_first].parent == parent)
+	{
+		RESULT_OK();
+		return;
+	}
+	const uint64_t l_last	= HierarchySubtreeEnd(l_first);
+	uint64_t	   l_target = l_array->dcursor_;
+	uint64_t	   l_depth	= 0;
+	if (parent != INVALID_ENTITY_ID)
+	{
+		const uint64_t l_parent = l_array->eindex_[parent];
+		if (l_parent >= l_first && l_parent < l_last)
+		{
+			RESULT_ERROR(EcsHierarchyCycle);
+		}
+		l_target = l_parent + 1;
+		l_depth	 = l_array->data_[l_parent].depth + 1;
+	}
+
+	// The whole subtree moves by the same depth
+	const uint64_t l_base			= l_array->data_[l_first].depth;
+	l_array->data_[l_first].parent = parent;
+	for (uint64_t l_index = l_first; l_index < l_last; ++l_index)
+	{
+		l_array->data_[l_index].depth = l_array->data_[l_index].depth - l_base + l_depth;
+		l_array->changed_[l_index]	  = tick_;
+	}
+
+	// Only the components between the old and the new place of the subtree shift
+	if (l_target < l_first)
+	{
+		l_array->Rotate(l_target, l_first, l_last);
+	}
+	else if (l_target > l_last)
+	{
+		l_array->Rotate(l_first, l_last, l_target);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+entity_id_t Registry<TypeList>::Parent(const entity_id_t id, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG(INVALID_ENTITY_ID);
+	if (id >= Capacity())
+	{
+		RESULT_ERROR(EcsInvalidEntityId, INVALID_ENTITY_ID);
+	}
+	auto& l_element = GetComponentArrayElement<HierarchyComponent>();
+	RESULT_OK();
+	const HierarchyComponent* l_node = l_element.constructed ? l_element.Get()->Get(id) : nullptr;
+	return l_node ? l_node->parent : INVALID_ENTITY_ID;
+}
+
+template<typename TypeList>
+template<typename Function>
+void Registry<TypeList>::EachHierarchy(Function&& function, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (auto& l_element = GetComponentArrayElement<HierarchyComponent>(); l_element.constructed)
+	{
+		l_element.Get()->Each([&](const entity_id_t id, const HierarchyComponent& node) { function(id, node); });
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+template<typename... Components, typename Function, typename Iterate>
+void Registry<TypeList>::ViewInternal(Function&& function, Iterate&& iterate)
+{
+	// A component that was never added or enabled cannot match any entity
+	if (!((IsTagComponent<Components>::VALUE || GetComponentArrayElement<Components>().constructed) && ...))
+	{
+		return;
+	}
+
+	signature_t l_mask{};
+	(l_mask.set(GetComponentId<Components>()), ...);
+
+	const auto l_visit = [&](const entity_id_t id) {
+		if ((signatures_[id] & l_mask) == l_mask)
+		{
+			VisitView<Components...>(id, function);
+		}
+	};
+
+	// Tags only, the signatures are the whole storage
+	if constexpr ((IsTagComponent<Components>::VALUE && ...))
+	{
+		iterate(Capacity(), PagedArray<signature_t>::CACHE_LINE_ELEMENTS,
+				[&](const uint64_t begin, const uint64_t end) { EachSignature(l_mask, begin, end, l_visit); });
+	}
+	else
+	{
+		// Drive the iteration by the smallest component set, tags have no set
+		signature_t l_driver{};
+		uint64_t	l_min_size = eastl::numeric_limits<uint64_t>::max();
+		(
+			[&] {
+				if constexpr (!IsTagComponent<Components>::VALUE)
+				{
+					const uint64_t l_size = GetComponentArrayElement<Components>().Get()->Size();
+					if (l_size < l_min_size)
+					{
+						l_min_size = l_size;
+						l_driver.reset();
+						l_driver.set(GetComponentId<Components>());
+					}
+				}
+			}(),
+			...);
+
+		if (l_min_size == 0)
+		{
+			return;
+		}
+
+		(
+			[&] {
+				if constexpr (!IsTagComponent<Components>::VALUE)
+				{
+					if (l_driver.test(GetComponentId<Components>()))
+					{
+						component_array_t<Components>* l_array = GetComponentArrayElement<Components>().Get();
+						iterate(l_array->Slots(), component_array_t<Components>::CACHE_LINE_ELEMENTS,
+								[&](const uint64_t begin, const uint64_t end) {
+									// SoA and shared drivers must not store their own copy back over the one of the view
+									if constexpr (IsSoaComponent<Components>::VALUE ||
+												  IsSharedComponent<Components>::VALUE)
+									{
+										l_array->EachEntityRange(begin, end, l_visit);
+									}
+									else
+									{
+										l_array->EachRange(begin, end,
+														   [&](const entity_id_t id, Components&) { l_visit(id); });
+									}
+								});
+					}
+				}
+			}(),
+			...);
+	}
+}
+
+template<typename TypeList>
+template<typename... Components, typename Function>
+void Registry<TypeList>::VisitView(const entity_id_t id, Function& function)
+{
+	// Enabled components are not guaranteed to hold data, so every array is still checked
+	eastl::tuple<view_slot_t<Components>...> l_slots{};
+	const eastl::tuple<Components*...>		 l_components{
+		  GetViewComponent<Components>(id, eastl::get<view_slot_t<Components>>(l_slots))...};
+	if ((eastl::get<Components*>(l_components) && ...))
+	{
+		function(id, *eastl::get<Components*>(l_components)...);
+		(StoreViewComponent<Components>(id, eastl::get<view_slot_t<Components>>(l_slots)), ...);
 	}
-	return reinterpret_cast<Component*>(data_ + eindex_[id]);
 }
 
 template<typename TypeList>
-template<typename Component>
-bool Registry<TypeList>::ComponentArray<Component>::Contains(const entity_id_t id) const
+uint64_t Registry<TypeList>::AlignGrain(const uint64_t grain, const uint64_t step)
 {
-	return eindex_[id] != INVALID_COMPONENT_ID;
+	return eastl::max(step, (grain + step - 1) / step * step);
 }
 
 template<typename TypeList>
 template<typename Component>
-Registry<TypeList>::ComponentArrayElement<Component>::ComponentArrayElement() : constructed{false}
+Component& Registry<TypeList>::TagInstance()
 {
-	Memory::ClearMemoryType(&memory);
+	static Component l_instance{};
+	return l_instance;
 }
 
 template<typename TypeList>
 template<typename Component>
-void Registry<TypeList>::ComponentArrayElement<Component>::ConstructIfAllowed(uint64_t capacity)
+Component* Registry<TypeList>::GetComponentData(const entity_id_t id)
 {
-	if (!constructed)
+	if constexpr (IsTagComponent<Component>::VALUE)
 	{
-		constructed = true;
-		new (memory.mCharData) ComponentArrayType{capacity};
+		return signatures_[id].test(GetComponentId<Component>()) ? &TagInstance<Component>() : nullptr;
+	}
+	else
+	{
+		return GetComponentArrayElement<Component>().Get()->Get(id);
 	}
 }
 
 template<typename TypeList>
 template<typename Component>
-void Registry<TypeList>::ComponentArrayElement<Component>::DestroyIfAllowed()
+Component* Registry<TypeList>::GetViewComponent(const entity_id_t id, view_slot_t<Component>& slot)
 {
-	if (constructed)
+	if constexpr (IsSoaComponent<Component>::VALUE)
 	{
-		constructed = false;
-		reinterpret_cast<ComponentArrayType*>(memory.mCharData)->~ComponentArrayType();
+		auto* l_array = GetComponentArrayElement<Component>().Get();
+		if (!l_array->Contains(id))
+		{
+			return nullptr;
+		}
+		slot.value = l_array->Load(id);
+		return &slot;
+	}
+	else if constexpr (IsSharedComponent<Component>::VALUE)
+	{
+		auto* l_array = GetComponentArrayElement<Component>().Get();
+		if (!l_array->Contains(id))
+		{
+			return nullptr;
+		}
+		slot = l_array->Load(id);
+		return &slot;
+	}
+	else
+	{
+		return GetComponentData<Component>(id);
 	}
 }
 
 template<typename TypeList>
 template<typename Component>
-typename Registry<TypeList>::template ComponentArrayElement<Component>::ComponentArrayType* Registry<
-	TypeList>::ComponentArrayElement<Component>::Get()
+void Registry<TypeList>::StoreViewComponent(const entity_id_t id, const view_slot_t<Component>& slot)
 {
-	return reinterpret_cast<ComponentArrayType*>(memory.mCharData);
+	if constexpr (IsSoaComponent<Component>::VALUE)
+	{
+		GetComponentArrayElement<Component>().Get()->Store(id, slot.value);
+	}
+	else if constexpr (IsSharedComponent<Component>::VALUE)
+	{
+		GetComponentArrayElement<Component>().Get()->Store(id, slot);
+	}
 }
 
 template<typename TypeList>
-template<typename Component>
-constexpr uint64_t Registry<TypeList>::GetComponentId()
+template<typename Function>
+void Registry<TypeList>::EachSignature(const signature_t& mask, const uint64_t begin, uint64_t end,
+									   Function&& function) const
 {
-	return TypeTraits::FindTupleType<ComponentArrayElement<Component>, component_map_tuple_t>();
+	end = eastl::min(end, Capacity());
+	for (uint64_t l_id = begin; l_id < end; ++l_id)
+	{
+		if ((signatures_[l_id] & mask) == mask)
+		{
+			function(entity_id_t{l_id});
+		}
+	}
 }
 
 template<typename TypeList>
-template<typename Component>
-typename Registry<TypeList>::template ComponentArrayElement<Component>& Registry<TypeList>::GetComponentArrayElement()
+tick_t Registry<TypeList>::Tick() const
 {
-	return eastl::get<GetComponentId<Component>()>(components_map_);
+	return tick_;
 }
 
 template<typename TypeList>
-template<uint64_t Index>
-void Registry<TypeList>::ConstructComponentsMap()
+tick_t Registry<TypeList>::AdvanceTick()
 {
-	if constexpr (Index < components_t::SIZE)
-	{
-		using Type = eastl::tuple_element_t<Index, component_map_tuple_t>;
-		new (eastl::addressof(eastl::get<Index>(components_map_))) Type{};
-		ConstructComponentsMap<Index + 1>();
-	}
+	return tick_++;
 }
 
 template<typename TypeList>
-template<uint64_t Index>
-void Registry<TypeList>::MoveComponentsMap(component_map_tuple_t&& map)
+template<typename Component>
+void Registry<TypeList>::MarkChanged(const entity_id_t id, RESULT_PARAM_IMPL)
 {
-	if constexpr (Index < components_t::SIZE)
+	static_assert(!IsTagComponent<Component>::VALUE, "Tags have no data to change.");
+	RESULT_ENSURE_LAST_NOLOG();
+	if (id >= Capacity())
 	{
-		eastl::get<Index>(components_map_) = eastl::move(eastl::get<Index>(map));
-		MoveComponentsMap<Index + 1>();
+		RESULT_ERROR(EcsInvalidEntityId);
 	}
-}
-
-template<typename TypeList>
-template<uint64_t Index>
-void Registry<TypeList>::DestroyComponentsMap()
-{
-	if constexpr (Index < components_t::SIZE)
+	auto&	l_element = GetComponentArrayElement<Component>();
+	tick_t* l_tick	  = l_element.constructed ? l_element.Get()->ChangedTick(id) : nullptr;
+	if (!l_tick)
 	{
-		eastl::get<Index>(components_map_).DestroyIfAllowed();
-		DestroyComponentsMap<Index + 1>();
+		RESULT_ERROR(EcsComponentDataNotAdded);
 	}
+	*l_tick = tick_;
+	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::ComponentPtr(Registry* registry, Ptr<Component> component)
-	: registry_{registry}, component_{eastl::move(component)}
+template<typename Component, typename Function>
+void Registry<TypeList>::Changed(const tick_t since, Function&& function, RESULT_PARAM_IMPL)
 {
+	RESULT_ENSURE_LAST_NOLOG();
+	EachSinceInternal<false, Component>(since, eastl::forward<Function>(function));
+	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::ComponentPtr(ComponentPtr&&) noexcept = default;
-template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::ComponentPtr(const ComponentPtr&) = default;
-template<typename TypeList>
-template<typename Component>
-typename Registry<TypeList>::template ComponentPtr<Component>& Registry<TypeList>::ComponentPtr<Component>::operator=(
-	ComponentPtr&&) noexcept = default;
-template<typename TypeList>
-template<typename Component>
-typename Registry<TypeList>::template ComponentPtr<Component>& Registry<TypeList>::ComponentPtr<Component>::operator=(
-	const ComponentPtr&) = default;
-template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::~ComponentPtr() = default;
+template<typename Component, typename Function>
+void Registry<TypeList>::Added(const tick_t since, Function&& function, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	EachSinceInternal<true, Component>(since, eastl::forward<Function>(function));
+	RESULT_OK();
+}
 
 template<typename TypeList>
-template<typename Component>
-auto& Registry<TypeList>::ComponentPtr<Component>::operator->()
+template<bool Added, typename Component, typename Function>
+void Registry<TypeList>::EachSinceInternal(const tick_t since, Function&& function)
 {
-	return component_;
+	static_assert(!IsTagComponent<Component>::VALUE, "Tags have no ticks.");
+	auto& l_element = GetComponentArrayElement<Component>();
+	if (l_element.constructed)
+	{
+		l_element.Get()->template EachSince<Added>(since, eastl::forward<Function>(function));
+	}
 }
 
 template<typename TypeList>
-template<typename Component>
-auto& Registry<TypeList>::ComponentPtr<Component>::operator->() const
+uint64_t Registry<TypeList>::Capacity(RESULT_PARAM_IMPL) const
 {
-	return component_;
+	return entities_.Capacity();
 }
 
 template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::operator Component*()
+uint64_t Registry<TypeList>::Size(RESULT_PARAM_IMPL) const
 {
-	return component_;
+	return ecursor_;
 }
 
 template<typename TypeList>
-template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::operator Component*() const
+typename Registry<TypeList>::RegistryStats Registry<TypeList>::Stats(RESULT_PARAM_IMPL) const
 {
-	return component_;
+	RegistryStats l_stats{};
+	l_stats.entity_capacity = Capacity();
+	l_stats.entity_size		= ecursor_.load(eastl::memory_order_relaxed);
+	l_stats.entity_bytes	= entities_.Bytes() + positions_.Bytes() + generations_.Bytes();
+	l_stats.signature_bytes = signatures_.Bytes();
+	l_stats.total_bytes		= l_stats.entity_bytes + l_stats.signature_bytes;
+	StatsComponentsMap<0>(l_stats);
+	return l_stats;
 }
 
 template<typename TypeList>
 template<typename Component>
-Registry<TypeList>::ComponentPtr<Component>::operator bool() const
+uint64_t Registry<TypeList>::Compact(const uint64_t budget, RESULT_PARAM_IMPL)
 {
-	return component_;
+	static_assert(ComponentStorageOf<Component>::VALUE == ComponentStorage::eSparse &&
+					  !IsTagComponent<Component>::VALUE,
+				  "Only sparse storage has holes to compact.");
+	RESULT_ENSURE_LAST_NOLOG(0);
+	auto& l_element = GetComponentArrayElement<Component>();
+	RESULT_OK();
+	return l_element.constructed ? l_element.Get()->Compact(budget) : 0;
 }
 
 template<typename TypeList>
-Registry<TypeList>::Registry(const uint64_t capacity, RESULT_PARAM_IMPL)
+bool Registry<TypeList>::Contains(const entity_id_t id, RESULT_PARAM_IMPL) const
 {
-	ValidateComponentTuple<typename TypeTraits::TlToTuple<TypeList>::type_t>();
-
-	signatures_ = static_cast<signature_t*>(EASTLAllocatorType("Ecs").allocate(capacity * sizeof(signature_t)));
-	ebegin_		= static_cast<entity_id_t*>(EASTLAllocatorType("Ecs").allocate(capacity * sizeof(entity_id_t)));
-	eend_		= ebegin_ + capacity;
-	ecursor_	= ebegin_;
-	ConstructComponentsMap<0>();
+	return id < Capacity();
 }
 
 template<typename TypeList>
-Registry<TypeList>::Registry(Registry&& other) noexcept
-	: ebegin_{other.ebegin_}, eend_{other.eend_}, ecursor_{other.ecursor_}, signatures_{other.signatures_}
+void Registry<TypeList>::Reserve(const uint64_t capacity, RESULT_PARAM_IMPL)
 {
-	MoveComponentsMap<0>(eastl::move(other.components_map_));
-	other.ecursor_ = other.eend_ = other.ebegin_ = nullptr;
-	other.signatures_							 = nullptr;
+	RESULT_ENSURE_LAST_NOLOG();
+	while (Capacity() < capacity)
+	{
+		GrowEntities();
+	}
+	RESULT_OK();
 }
 
 template<typename TypeList>
-Registry<TypeList>& Registry<TypeList>::operator=(Registry&& other) noexcept
+void Registry<TypeList>::Clear(RESULT_PARAM_IMPL)
 {
-	MoveComponentsMap<0>(eastl::move(other.components_map_));
-
-	signatures_ = other.signatures_;
-	ebegin_		= other.ebegin_;
-	eend_		= other.eend_;
-	ecursor_	= other.ecursor_;
+	DestroyComponentsMap<0>();
 
-	other.signatures_ = nullptr;
-	other.ecursor_ = other.eend_ = other.ebegin_ = nullptr;
-	return *this;
+	entities_.Clear();
+	positions_.Clear();
+	signatures_.Clear();
+	generations_.Clear();
+	ecursor_ = 0;
+	for (GroupState& l_group : groups_)
+	{
+		l_group.size = 0;
+	}
+	RebuildQueries();
 }
 
 template<typename TypeList>
-Registry<TypeList>::~Registry()
+uint64_t Registry<TypeList>::HierarchySubtreeEnd(const uint64_t first)
 {
-	DestroyComponentsMap<0>();
-
-	EASTLAllocatorType("Ecs").deallocate(ebegin_, 0);
-	ebegin_ = eend_ = ecursor_ = nullptr;
-
-	EASTLAllocatorType("Ecs").deallocate(signatures_, 0);
-	signatures_ = nullptr;
+	auto*		   l_array = GetComponentArrayElement<HierarchyComponent>().Get();
+	const uint64_t l_depth = l_array->data_[first].depth;
+	uint64_t	   l_last  = first + 1;
+	while (l_last < l_array->dcursor_ && l_array->data_[l_last].depth > l_depth)
+	{
+		++l_last;
+	}
+	return l_last;
 }
 
 template<typename TypeList>
-entity_id_t Registry<TypeList>::Create(RESULT_PARAM_IMPL)
+void Registry<TypeList>::DetachHierarchy(const entity_id_t id)
 {
-	RESULT_ENSURE_LAST_NOLOG(INVALID_ENTITY_ID);
-	if (!Contains(ecursor_))
+	auto& l_element = GetComponentArrayElement<HierarchyComponent>();
+	if (!l_element.constructed || !l_element.Get()->Contains(id))
 	{
-		RESULT_ERROR(EcsNoEntityAvailable, INVALID_ENTITY_ID);
+		return;
 	}
-	if (*ecursor_ >= Capacity())
+	auto*			  l_array  = l_element.Get();
+	const uint64_t	  l_first  = l_array->eindex_[id];
+	const uint64_t	  l_last   = HierarchySubtreeEnd(l_first);
+	const entity_id_t l_parent = l_array->data_[l_first].parent;
+
+	// The descendants stay in place one level up, the children take the place of the entity
+	for (uint64_t l_index = l_first + 1; l_index < l_last; ++l_index)
 	{
-		*ecursor_ = ecursor_ - ebegin_;
+		HierarchyComponent& l_node = l_array->data_[l_index];
+		--l_node.depth;
+		if (l_node.parent == id)
+		{
+			l_node.parent = l_parent;
+		}
+		l_array->changed_[l_index] = tick_;
 	}
-	const auto l_id = *ecursor_++;
-	new (signatures_ + l_id) signature_t{};
-	RESULT_OK();
-	return l_id;
+	l_array->Rotate(l_first, l_first + 1, l_array->dcursor_);
 }
 
 template<typename TypeList>
-void Registry<TypeList>::Destroy(entity_id_t id, RESULT_PARAM_IMPL)
+typename Registry<TypeList>::GroupState& Registry<TypeList>::GroupOf(const uint64_t component_id)
 {
-	RESULT_ENSURE_LAST_NOLOG();
-	if (id >= Capacity())
+	ASSERT(owned_.test(component_id));
+	return *eastl::find_if(groups_.begin(), groups_.end(),
+						   [&](const GroupState& group) { return group.owned.test(component_id); });
+}
+
+template<typename TypeList>
+void Registry<TypeList>::GroupEnter(GroupState& group, const entity_id_t id)
+{
+	if (ContainsComponentsMap<0>(group.owned, id) && SlotComponentsMap<0>(group.owned, id) >= group.size)
 	{
-		RESULT_ERROR(EcsInvalidEntityId);
+		SwapComponentsMap<0>(group.owned, id, group.size++);
 	}
-	*--ecursor_ = id;
-	signatures_[id].reset();
-	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename... Components>
-void Registry<TypeList>::Enable(const entity_id_t id, RESULT_PARAM_IMPL)
+void Registry<TypeList>::GroupLeave(GroupState& group, const entity_id_t id)
 {
-	RESULT_ENSURE_LAST_NOLOG();
-	if (id >= Capacity())
+	if (SlotComponentsMap<0>(group.owned, id) < group.size)
 	{
-		RESULT_ERROR(EcsInvalidEntityId);
+		SwapComponentsMap<0>(group.owned, id, --group.size);
 	}
-	(SetEnabledInternal<Components>(id, true), ...);
-	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename... Components>
-void Registry<TypeList>::Disable(const entity_id_t id, RESULT_PARAM_IMPL)
+void Registry<TypeList>::RebuildGroups()
 {
-	RESULT_ENSURE_LAST_NOLOG();
-	if (id >= Capacity())
+	for (GroupState& l_group : groups_)
 	{
-		RESULT_ERROR(EcsInvalidEntityId);
+		l_group.size = 0;
+		FillGroupComponentsMap<0>(l_group);
 	}
-	(SetEnabledInternal<Components>(id, false), ...);
-	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename Component>
-bool Registry<TypeList>::IsEnabled(const entity_id_t id, RESULT_PARAM_IMPL) const
+template<uint64_t Index>
+bool Registry<TypeList>::ContainsComponentsMap(const signature_t& mask, const entity_id_t id)
 {
-	if (id >= Capacity())
+	if constexpr (Index < components_t::SIZE)
 	{
-		RESULT_ERROR(EcsInvalidEntityId, false);
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+		if constexpr (!IsTagComponent<component_t>::VALUE)
+		{
+			if (auto& l_element = eastl::get<Index>(components_map_);
+				mask.test(Index) && (!l_element.constructed || !l_element.Get()->Contains(id)))
+			{
+				return false;
+			}
+		}
+		return ContainsComponentsMap<Index + 1>(mask, id);
+	}
+	else
+	{
+		return true;
 	}
-	RESULT_OK();
-	return signatures_[id].test(GetComponentId<Component>());
 }
 
 template<typename TypeList>
-template<typename Component>
-void Registry<TypeList>::Add(const entity_id_t id, Component&& component, RESULT_PARAM_IMPL)
+template<uint64_t Index>
+uint64_t Registry<TypeList>::SlotComponentsMap(const signature_t& mask, const entity_id_t id)
 {
-	RESULT_ENSURE_LAST_NOLOG();
-	if (id >= Capacity())
+	if constexpr (Index < components_t::SIZE)
 	{
-		RESULT_ERROR(EcsInvalidEntityId);
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+		if constexpr (ComponentStorageOf<component_t>::VALUE == ComponentStorage::eDense &&
+					  !IsTagComponent<component_t>::VALUE)
+		{
+			if (mask.test(Index))
+			{
+				auto& l_element = eastl::get<Index>(components_map_);
+				return l_element.constructed && l_element.Get()->Contains(id) ? l_element.Get()->eindex_[id]
+																			  : INVALID_ENTITY_ID;
+			}
+		}
+		return SlotComponentsMap<Index + 1>(mask, id);
 	}
-
-	constexpr uint64_t l_id				   = GetComponentId<Component>();
-	auto&			   l_component_element = GetComponentArrayElement<Component>();
-
-	// Enable component inline
-	if (!signatures_[id].test(l_id))
+	else
 	{
-		signatures_[id].set(l_id);
-		l_component_element.ConstructIfAllowed(Capacity());
+		return INVALID_ENTITY_ID;
 	}
-
-	// Add component
-	l_component_element.Get()->Add(id, eastl::forward<Component>(component));
-	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename Component>
-void Registry<TypeList>::Remove(const entity_id_t id, RESULT_PARAM_IMPL)
+template<uint64_t Index>
+void Registry<TypeList>::SwapComponentsMap(const signature_t& mask, const entity_id_t id, const uint64_t slot)
 {
-	RESULT_ENSURE_LAST_NOLOG();
-	if (id >= Capacity())
+	if constexpr (Index < components_t::SIZE)
 	{
-		RESULT_ERROR(EcsInvalidEntityId);
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+		if constexpr (ComponentStorageOf<component_t>::VALUE == ComponentStorage::eDense &&
+					  !IsTagComponent<component_t>::VALUE)
+		{
+			if (mask.test(Index))
+			{
+				auto* l_array = eastl::get<Index>(components_map_).Get();
+				l_array->Swap(l_array->eindex_[id], slot);
+			}
+		}
+		SwapComponentsMap<Index + 1>(mask, id, slot);
 	}
-	constexpr uint64_t l_id = GetComponentId<Component>();
-	signatures_[id].set(l_id, false);
-	GetComponentArrayElement<Component>().Get()->Remove(id);
-	RESULT_OK();
 }
 
 template<typename TypeList>
-template<typename Component>
-typename Registry<TypeList>::template ComponentPtr<Component> Registry<TypeList>::Get(const entity_id_t id,
-																					  RESULT_PARAM_IMPL)
+template<uint64_t Index>
+void Registry<TypeList>::FillGroupComponentsMap(GroupState& group)
 {
-	RESULT_ENSURE_LAST_NOLOG(ComponentPtr<Component>{this, nullptr});
-	if (!IsEnabled<Component>(id))
+	if constexpr (Index < components_t::SIZE)
 	{
-		RESULT_ERROR(EcsComponentNotEnabled, ComponentPtr<Component>{this, nullptr});
+		using element_t	  = eastl::tuple_element_t<Index, component_map_tuple_t>;
+		using component_t = typename element_t::ComponentArrayType::component_t;
+		if constexpr (ComponentStorageOf<component_t>::VALUE == ComponentStorage::eDense &&
+					  !IsTagComponent<component_t>::VALUE)
+		{
+			// Entering swaps with a visited slot only, so one pass over the first owned array finds every entity
+			if (group.owned.test(Index))
+			{
+				if (auto& l_element = eastl::get<Index>(components_map_); l_element.constructed)
+				{
+					auto* l_array = l_element.Get();
+					for (uint64_t l_slot = 0; l_slot < l_array->Slots(); ++l_slot)
+					{
+						GroupEnter(group, l_array->dentity_[l_slot]);
+					}
+				}
+				return;
+			}
+		}
+		FillGroupComponentsMap<Index + 1>(group);
 	}
-	RESULT_OK();
-	return ComponentPtr<Component>{this, PTR(GetComponentArrayElement<Component>().Get()->Get(id))};
 }
 
 template<typename TypeList>
-template<typename Component>
-void Registry<TypeList>::Each(void (*function)(Component&), RESULT_PARAM_IMPL)
+typename Registry<TypeList>::QueryState* Registry<TypeList>::FindQuery(const signature_t& mask)
 {
-	auto	   l_comp		= GetComponentArrayElement<Component>().Get();
-	const auto l_data		= l_comp->data_;
-	auto	   l_eindex		= l_comp->eindex_;
-	const auto l_eindex_end = l_comp->eindex_end_;
+	// Few queries are cached, a linear scan of the masks is cheaper than hashing them
+	for (QueryState& l_query : queries_)
+	{
+		if (l_query.mask == mask)
+		{
+			return &l_query;
+		}
+	}
+	return nullptr;
+}
 
-	while (l_eindex < l_eindex_end)
+template<typename TypeList>
+void Registry<TypeList>::QueryUpdate(const entity_id_t id, const signature_t& before)
+{
+	const signature_t& l_after = signatures_[id];
+	for (QueryState& l_query : queries_)
 	{
-		if (*l_eindex != ComponentArray<Component>::INVALID_COMPONENT_ID)
+		const bool l_was = (before & l_query.mask) == l_query.mask;
+		const bool l_is	 = (l_after & l_query.mask) == l_query.mask;
+		if (l_was != l_is)
 		{
-			function(*(l_data + *l_eindex));
+			l_is ? QueryInsert(l_query, id) : QueryErase(l_query, id);
 		}
-		++l_eindex;
 	}
 }
 
 template<typename TypeList>
-uint64_t Registry<TypeList>::Capacity(RESULT_PARAM_IMPL) const
+void Registry<TypeList>::QueryInsert(QueryState& query, const entity_id_t id)
 {
-	return eend_ - ebegin_;
+	ASSERT(query.entities.size() < INVALID_QUERY_INDEX);
+	query.index.AssurePage(PagedArray<uint32_t>::PageOf(id), INVALID_QUERY_INDEX);
+	query.index[id] = static_cast<uint32_t>(query.entities.size());
+	query.entities.push_back(id);
 }
 
 template<typename TypeList>
-bool Registry<TypeList>::Contains(const entity_id_t* ptr, RESULT_PARAM_IMPL) const
+void Registry<TypeList>::QueryErase(QueryState& query, const entity_id_t id)
 {
-	return ptr >= ebegin_ && ptr < eend_;
+	const uint32_t	  l_index = eastl::exchange(query.index[id], INVALID_QUERY_INDEX);
+	const entity_id_t l_last  = query.entities.back();
+	query.entities.pop_back();
+	if (l_last != id)
+	{
+		query.entities[l_index] = l_last;
+		query.index[l_last]		= l_index;
+	}
 }
 
 template<typename TypeList>
-void Registry<TypeList>::Clear(RESULT_PARAM_IMPL)
+void Registry<TypeList>::RebuildQueries()
 {
-	// entities_.clear();
+	for (QueryState& l_query : queries_)
+	{
+		l_query.entities.clear();
+		l_query.index.Clear();
+		EachSignature(l_query.mask, 0, Capacity(), [&](const entity_id_t id) { QueryInsert(l_query, id); });
+	}
+}
 
-	EASTLAllocatorType("Ecs").deallocate(ebegin_, 0);
-	ebegin_ = eend_ = ecursor_ = nullptr;
+template<typename TypeList>
+void Registry<TypeList>::GrowEntities()
+{
+	// Entity pages are allocated in sequence, the new page receives the next never used ids
+	const uint64_t	   l_page	  = entities_.PageCount();
+	const entity_id_t  l_first_id = l_page * PagedArray<entity_id_t>::PAGE_SIZE;
+	entity_id_t* const l_ids	  = entities_.AssurePage(l_page);
+	eastl::iota(l_ids, l_ids + PagedArray<entity_id_t>::PAGE_SIZE, l_first_id);
+	entity_id_t* const l_positions = positions_.AssurePage(l_page);
+	eastl::iota(l_positions, l_positions + PagedArray<entity_id_t>::PAGE_SIZE, l_first_id);
+	signatures_.AssurePage(l_page, signature_t{});
+	generations_.AssurePage(l_page, generation_t{});
+}
 
-	EASTLAllocatorType("Ecs").deallocate(signatures_, 0);
-	signatures_ = nullptr;
+template<typename TypeList>
+bool Registry<TypeList>::IsLive(const entity_id_t id) const
+{
+	const PagedArray<entity_id_t>& l_positions = positions_;
+	return id < Capacity() && l_positions[id] < ecursor_.load(eastl::memory_order_relaxed);
+}
 
-	DestroyComponentsMap<0>();
+template<typename TypeList>
+void Registry<TypeList>::ReleaseEntity(const entity_id_t id, const uint64_t last)
+{
+	const entity_id_t l_position = positions_[id];
+	const entity_id_t l_last_id	 = entities_[last];
+	entities_[l_position]		 = l_last_id;
+	positions_[l_last_id]		 = l_position;
+	entities_[last]				 = id;
+	positions_[id]				 = last;
+}
+
+template<typename TypeList>
+bool Registry<TypeList>::RebuildPositions()
+{
+	const PagedArray<entity_id_t>& l_entities = entities_;
+	positions_.Clear();
+	for (uint64_t l_page = 0; l_page < l_entities.PageCount(); ++l_page)
+	{
+		positions_.AssurePage(l_page, INVALID_ENTITY_ID);
+	}
+	constexpr uint64_t l_page_size = PagedArray<entity_id_t>::PAGE_SIZE;
+	for (uint64_t l_page = 0; l_page < l_entities.PageCount(); ++l_page)
+	{
+		const entity_id_t* const l_ids = l_entities.Page(l_page);
+		if (!l_ids)
+		{
+			return false;
+		}
+		for (uint64_t l_offset = 0; l_offset < l_page_size; ++l_offset)
+		{
+			const entity_id_t l_id = l_ids[l_offset];
+			if (l_id >= l_entities.Capacity() || positions_[l_id] != INVALID_ENTITY_ID)
+			{
+				return false;
+			}
+			positions_[l_id] = l_page * l_page_size + l_offset;
+		}
+	}
+	return true;
 }
 
 template<typename TypeList>
@@ -705,14 +5037,19 @@ void Registry<TypeList>::SetEnabledInternal(const entity_id_t id, const bool val
 {
 	RESULT_ENSURE_LAST_NOLOG();
 	constexpr uint64_t l_id = GetComponentId<Component>();
-	if (signatures_[id].test(l_id))
+	if (signatures_[id].test(l_id) == value)
 	{
-		RESULT_ERROR(EcsComponentAlreadyEnabled);
+		RESULT_ERROR(value ? EcsComponentAlreadyEnabled : EcsComponentNotEnabled);
 	}
+	const signature_t l_before = signatures_[id];
 	signatures_[id].set(l_id, value);
-	if (value)
+	QueryUpdate(id, l_before);
+	if constexpr (!IsTagComponent<Component>::VALUE)
 	{
-		GetComponentArrayElement<Component>().ConstructIfAllowed(Capacity());
+		if (value)
+		{
+			GetComponentArrayElement<Component>().ConstructIfAllowed();
+		}
 	}
 	RESULT_OK();
 }
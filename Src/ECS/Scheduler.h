@@ -0,0 +1,257 @@
+/** @file Scheduler.h
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#ifndef ECS_SCHEDULER_H
+#define ECS_SCHEDULER_H
+
+#include "Core/Common.h"
+#include "Core/JobPool.h"
+#include "ECS/Registry.h"
+
+#include <EASTL/functional.h>
+#include <EASTL/vector.h>
+
+namespace Ecs
+{
+
+namespace Detail
+{
+
+template<typename Signature, typename Tuple, typename Components>
+struct SchedulerSignature;
+
+template<typename Signature, typename Tuple, typename... Components>
+struct SchedulerSignature<Signature, Tuple, TypeTraits::TypeList<Components...>>
+{
+	static Signature Get()
+	{
+		Signature l_signature{};
+		(l_signature.set(TypeTraits::FindTupleType<Components, Tuple>()), ...);
+		return l_signature;
+	}
+};
+
+} // namespace Detail
+
+/**
+ * @brief System scheduler class.
+ *
+ * Runs systems that declare the components they read and write, so systems without conflicts run in parallel.
+ * Two systems conflict when one writes a component the other reads or writes; the one added first runs first.
+ *
+ * Data:
+ * 1. Array of systems with their read and write signatures.
+ * 2. Systems ordered by level, a level is the longest chain of conflicts that ends in the system.
+ *
+ * Behavior:
+ * 1. The levels are built on the first @ref Run after a system was added.
+ * 2. Levels run in order, the systems of a level run concurrently in the @ref JobPool.
+ *	A level with one system runs in the calling thread, so the system can use the pool itself (like
+ *	@ref Registry::ParallelView).
+ * 3. Systems must not change the registry structure (create, destroy, add or remove), record those changes in a
+ *	@ref CommandBuffer per system and apply them with @ref Registry::Playback after @ref Run.
+ * 4. Cached queries used by systems are registered with @ref Registry::Query before @ref Run. @ref Registry::EachQuery
+ *	only reads them, so systems of one level can use the same query.
+ *
+ * @tparam TypeList Component type list of the registry.
+ *
+ */
+template<typename TypeList>
+class Scheduler final
+{
+public:
+	using registry_t	= Registry<TypeList>;
+	using signature_t	= typename registry_t::signature_t;
+	using function_t	= eastl::function<void(registry_t&)>;
+
+public:
+	EXPLICIT Scheduler(JobPool& pool = JobPool::Default());
+
+	Scheduler(Scheduler&&) NOEXCEPT = default;
+	Scheduler(const Scheduler&)		= delete;
+	Scheduler& operator=(Scheduler&&) NOEXCEPT = default;
+	Scheduler& operator=(const Scheduler&)	   = delete;
+	~Scheduler()							   = default;
+
+public:
+	/**
+	 * @brief Add a system.
+	 *
+	 * @tparam Reads Type list of the components read by the system.
+	 * @tparam Writes Type list of the components written by the system.
+	 * @param name System name, it must outlive the scheduler.
+	 * @param function System function, called as function(registry).
+	 * @return System index.
+	 *
+	 */
+	template<typename Reads, typename Writes, typename Function>
+	uint64_t Add(const char* name, Function&& function);
+
+	/**
+	 * @brief Run every system once.
+	 *
+	 * @param registry Registry passed to the systems.
+	 *
+	 */
+	void Run(registry_t& registry, RESULT_PARAM_DEFINE);
+
+	NODISCARD uint64_t	  SystemCount() const;
+	NODISCARD const char* SystemName(uint64_t index) const;
+
+	/**
+	 * @brief Get level count, it is only valid after @ref Run.
+	 *
+	 * @return Level count, the same of the system count when every system conflicts with the previous one.
+	 *
+	 */
+	NODISCARD uint64_t LevelCount() const;
+
+private:
+	struct System
+	{
+		function_t	function;
+		const char* name;
+		signature_t reads;
+		signature_t writes;
+	};
+
+	NODISCARD static bool Conflicts(const System& first, const System& second);
+
+	void Build();
+
+private:
+	JobPool*				 pool_;
+	eastl::vector<System>	 systems_;
+	eastl::vector<uint64_t> order_;
+	eastl::vector<uint64_t> levels_;
+	bool					 dirty_{};
+};
+
+template<typename TypeList>
+Scheduler<TypeList>::Scheduler(JobPool& pool) : pool_{&pool}
+{
+}
+
+template<typename TypeList>
+template<typename Reads, typename Writes, typename Function>
+uint64_t Scheduler<TypeList>::Add(const char* name, Function&& function)
+{
+	using tuple_t = typename TypeTraits::TlToTuple<TypeList>::type_t;
+	systems_.push_back(System{function_t{eastl::forward<Function>(function)}, name,
+							  Detail::SchedulerSignature<signature_t, tuple_t, Reads>::Get(),
+							  Detail::SchedulerSignature<signature_t, tuple_t, Writes>::Get()});
+	dirty_ = true;
+	return systems_.size() - 1;
+}
+
+template<typename TypeList>
+void Scheduler<TypeList>::Run(registry_t& registry, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (dirty_)
+	{
+		Build();
+	}
+
+	for (uint64_t l_level = 0; l_level + 1 < levels_.size(); ++l_level)
+	{
+		const uint64_t l_begin = levels_[l_level];
+		const uint64_t l_count = levels_[l_level + 1] - l_begin;
+		if (l_count == 1)
+		{
+			systems_[order_[l_begin]].function(registry);
+			continue;
+		}
+
+		// Pages shared with a frozen registry are copied here, the systems of the level would copy them concurrently
+		signature_t l_mask{};
+		for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+		{
+			const System& l_system = systems_[order_[l_begin + l_index]];
+			l_mask |= l_system.reads | l_system.writes;
+		}
+		RESULT_ENSURE_CALL_NOLOG(registry.Unshare(l_mask, RESULT_ARG_PASS));
+		RESULT_ENSURE_CALL_NOLOG(pool_->ParallelFor(
+			l_count, 1,
+			[&](const uint64_t begin, const uint64_t end)
+			{
+				for (uint64_t l_index = begin; l_index < end; ++l_index)
+				{
+					systems_[order_[l_begin + l_index]].function(registry);
+				}
+			},
+			RESULT_ARG_PASS));
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+uint64_t Scheduler<TypeList>::SystemCount() const
+{
+	return systems_.size();
+}
+
+template<typename TypeList>
+const char* Scheduler<TypeList>::SystemName(const uint64_t index) const
+{
+	return systems_[index].name;
+}
+
+template<typename TypeList>
+uint64_t Scheduler<TypeList>::LevelCount() const
+{
+	return levels_.empty() ? 0 : levels_.size() - 1;
+}
+
+template<typename TypeList>
+bool Scheduler<TypeList>::Conflicts(const System& first, const System& second)
+{
+	return (first.writes & (second.reads | second.writes)).any() || (second.writes & first.reads).any();
+}
+
+template<typename TypeList>
+void Scheduler<TypeList>::Build()
+{
+	// Systems only depend on systems added before them, so one pass in add order finds the longest chains
+	const uint64_t			l_count = systems_.size();
+	eastl::vector<uint64_t> l_level(l_count, 0);
+	uint64_t				l_level_count = 0;
+	for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+	{
+		for (uint64_t l_previous = 0; l_previous < l_index; ++l_previous)
+		{
+			if (l_level[l_previous] >= l_level[l_index] && Conflicts(systems_[l_previous], systems_[l_index]))
+			{
+				l_level[l_index] = l_level[l_previous] + 1;
+			}
+		}
+		l_level_count = eastl::max(l_level_count, l_level[l_index] + 1);
+	}
+
+	// Counting sort by level, systems keep the add order inside a level
+	levels_.assign(l_level_count + 1, 0);
+	for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+	{
+		++levels_[l_level[l_index] + 1];
+	}
+	for (uint64_t l_index = 1; l_index < levels_.size(); ++l_index)
+	{
+		levels_[l_index] += levels_[l_index - 1];
+	}
+	order_.resize(l_count);
+	eastl::vector<uint64_t> l_next(levels_.begin(), levels_.end() - 1);
+	for (uint64_t l_index = 0; l_index < l_count; ++l_index)
+	{
+		order_[l_next[l_level[l_index]]++] = l_index;
+	}
+	dirty_ = false;
+}
+
+} // namespace Ecs
+
+#endif
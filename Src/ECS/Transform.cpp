@@ -0,0 +1,323 @@
+/** @file Transform.cpp
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#include "ECS/Transform.h"
+
+#if CPU_X86
+#include <immintrin.h>
+#endif
+
+#if CPU_X86 && defined(__AVX2__)
+#define ECS_TRANSFORM_AVX2 1
+#else
+#define ECS_TRANSFORM_AVX2 0
+#endif
+
+namespace Ecs
+{
+
+namespace Detail
+{
+
+/**
+ * @brief pi / 2 split in three parts, so the range reduction keeps precision for large angles.
+ */
+static constexpr float32_t PIO2_1	   = 1.5703125f;
+static constexpr float32_t PIO2_2	   = 4.837512969970703125e-4f;
+static constexpr float32_t PIO2_3	   = 7.54978995489188216e-8f;
+static constexpr float32_t TWO_OVER_PI = 0.636619772367581343f;
+
+struct LaneScalar
+{
+	float32_t v;
+
+	static LaneScalar Load(const float32_t* data)
+	{
+		return LaneScalar{*data};
+	}
+	static LaneScalar Set(const float32_t value)
+	{
+		return LaneScalar{value};
+	}
+	friend LaneScalar operator+(const LaneScalar a, const LaneScalar b)
+	{
+		return LaneScalar{a.v + b.v};
+	}
+	friend LaneScalar operator-(const LaneScalar a, const LaneScalar b)
+	{
+		return LaneScalar{a.v - b.v};
+	}
+	friend LaneScalar operator*(const LaneScalar a, const LaneScalar b)
+	{
+		return LaneScalar{a.v * b.v};
+	}
+};
+
+static void SinCos(const LaneScalar x, LaneScalar& s, LaneScalar& c)
+{
+	s.v = glm::sin(x.v);
+	c.v = glm::cos(x.v);
+}
+
+static void StoreMatrices(const LaneScalar (&columns)[12], glm::mat4* matrices)
+{
+	glm::mat4& l_matrix = *matrices;
+	for (uint64_t l_column = 0; l_column < 4; ++l_column)
+	{
+		l_matrix[l_column].x = columns[l_column * 3 + 0].v;
+		l_matrix[l_column].y = columns[l_column * 3 + 1].v;
+		l_matrix[l_column].z = columns[l_column * 3 + 2].v;
+		l_matrix[l_column].w = l_column == 3 ? 1.f : 0.f;
+	}
+}
+
+/**
+ * @brief Sine of [-pi/4, pi/4], minimax polynomial of Cephes.
+ */
+template<typename Lane>
+static Lane SinPolynomial(const Lane r)
+{
+	const Lane l_r2 = r * r;
+	return r + r * l_r2 *
+				   (Lane::Set(-1.6666654611e-1f) +
+					l_r2 * (Lane::Set(8.3321608736e-3f) + l_r2 * Lane::Set(-1.9515295891e-4f)));
+}
+
+/**
+ * @brief Cosine of [-pi/4, pi/4], minimax polynomial of Cephes.
+ */
+template<typename Lane>
+static Lane CosPolynomial(const Lane r)
+{
+	const Lane l_r2 = r * r;
+	return Lane::Set(1.f) - l_r2 * Lane::Set(0.5f) +
+		   l_r2 * l_r2 *
+			   (Lane::Set(4.166664568298827e-2f) +
+				l_r2 * (Lane::Set(-1.388731625493765e-3f) + l_r2 * Lane::Set(2.443315711809948e-5f)));
+}
+
+#if CPU_X86
+
+/**
+ * @brief Transpose the lanes of each column to the matrices of 4 entities.
+ */
+static void StoreMatrices(const __m128 (&columns)[12], glm::mat4* matrices)
+{
+	for (uint64_t l_column = 0; l_column < 4; ++l_column)
+	{
+		__m128 l_x = columns[l_column * 3 + 0];
+		__m128 l_y = columns[l_column * 3 + 1];
+		__m128 l_z = columns[l_column * 3 + 2];
+		__m128 l_w = l_column == 3 ? _mm_set1_ps(1.f) : _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(l_x, l_y, l_z, l_w);
+		_mm_storeu_ps(&matrices[0][l_column].x, l_x);
+		_mm_storeu_ps(&matrices[1][l_column].x, l_y);
+		_mm_storeu_ps(&matrices[2][l_column].x, l_z);
+		_mm_storeu_ps(&matrices[3][l_column].x, l_w);
+	}
+}
+
+#endif
+
+#if CPU_X86 && !ECS_TRANSFORM_AVX2
+
+struct LaneSse
+{
+	__m128 v;
+
+	static LaneSse Load(const float32_t* data)
+	{
+		return LaneSse{_mm_loadu_ps(data)};
+	}
+	static LaneSse Set(const float32_t value)
+	{
+		return LaneSse{_mm_set1_ps(value)};
+	}
+	friend LaneSse operator+(const LaneSse a, const LaneSse b)
+	{
+		return LaneSse{_mm_add_ps(a.v, b.v)};
+	}
+	friend LaneSse operator-(const LaneSse a, const LaneSse b)
+	{
+		return LaneSse{_mm_sub_ps(a.v, b.v)};
+	}
+	friend LaneSse operator*(const LaneSse a, const LaneSse b)
+	{
+		return LaneSse{_mm_mul_ps(a.v, b.v)};
+	}
+};
+
+static void SinCos(const LaneSse x, LaneSse& s, LaneSse& c)
+{
+	// Quadrant q of x = q * pi/2 + r, with r in [-pi/4, pi/4]
+	const __m128i l_q  = _mm_cvtps_epi32(_mm_mul_ps(x.v, _mm_set1_ps(TWO_OVER_PI)));
+	const __m128  l_qf = _mm_cvtepi32_ps(l_q);
+	__m128		  l_r  = _mm_sub_ps(x.v, _mm_mul_ps(l_qf, _mm_set1_ps(PIO2_1)));
+	l_r				   = _mm_sub_ps(l_r, _mm_mul_ps(l_qf, _mm_set1_ps(PIO2_2)));
+	l_r				   = _mm_sub_ps(l_r, _mm_mul_ps(l_qf, _mm_set1_ps(PIO2_3)));
+
+	const __m128 l_sin = SinPolynomial(LaneSse{l_r}).v;
+	const __m128 l_cos = CosPolynomial(LaneSse{l_r}).v;
+
+	// Odd quadrants swap sine and cosine, sine is negative in quadrants 2 and 3, cosine in 1 and 2
+	const __m128i l_one	 = _mm_set1_epi32(1);
+	const __m128i l_two	 = _mm_set1_epi32(2);
+	const __m128  l_swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(l_q, l_one), l_one));
+	const __m128  l_sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(l_q, l_two), 30));
+	const __m128  l_cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(l_q, l_one), l_two), 30));
+	s.v = _mm_xor_ps(_mm_or_ps(_mm_and_ps(l_swap, l_cos), _mm_andnot_ps(l_swap, l_sin)), l_sin_sign);
+	c.v = _mm_xor_ps(_mm_or_ps(_mm_and_ps(l_swap, l_sin), _mm_andnot_ps(l_swap, l_cos)), l_cos_sign);
+}
+
+static void StoreMatrices(const LaneSse (&columns)[12], glm::mat4* matrices)
+{
+	__m128 l_columns[12];
+	for (uint64_t l_index = 0; l_index < 12; ++l_index)
+	{
+		l_columns[l_index] = columns[l_index].v;
+	}
+	StoreMatrices(l_columns, matrices);
+}
+
+#endif
+
+#if ECS_TRANSFORM_AVX2
+
+struct LaneAvx
+{
+	__m256 v;
+
+	static LaneAvx Load(const float32_t* data)
+	{
+		return LaneAvx{_mm256_loadu_ps(data)};
+	}
+	static LaneAvx Set(const float32_t value)
+	{
+		return LaneAvx{_mm256_set1_ps(value)};
+	}
+	friend LaneAvx operator+(const LaneAvx a, const LaneAvx b)
+	{
+		return LaneAvx{_mm256_add_ps(a.v, b.v)};
+	}
+	friend LaneAvx operator-(const LaneAvx a, const LaneAvx b)
+	{
+		return LaneAvx{_mm256_sub_ps(a.v, b.v)};
+	}
+	friend LaneAvx operator*(const LaneAvx a, const LaneAvx b)
+	{
+		return LaneAvx{_mm256_mul_ps(a.v, b.v)};
+	}
+};
+
+static void SinCos(const LaneAvx x, LaneAvx& s, LaneAvx& c)
+{
+	// Same reduction of the SSE version
+	const __m256i l_q  = _mm256_cvtps_epi32(_mm256_mul_ps(x.v, _mm256_set1_ps(TWO_OVER_PI)));
+	const __m256  l_qf = _mm256_cvtepi32_ps(l_q);
+	__m256		  l_r  = _mm256_sub_ps(x.v, _mm256_mul_ps(l_qf, _mm256_set1_ps(PIO2_1)));
+	l_r				   = _mm256_sub_ps(l_r, _mm256_mul_ps(l_qf, _mm256_set1_ps(PIO2_2)));
+	l_r				   = _mm256_sub_ps(l_r, _mm256_mul_ps(l_qf, _mm256_set1_ps(PIO2_3)));
+
+	const __m256 l_sin = SinPolynomial(LaneAvx{l_r}).v;
+	const __m256 l_cos = CosPolynomial(LaneAvx{l_r}).v;
+
+	const __m256i l_one		 = _mm256_set1_epi32(1);
+	const __m256i l_two		 = _mm256_set1_epi32(2);
+	const __m256  l_swap	 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(l_q, l_one), l_one));
+	const __m256  l_sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(l_q, l_two), 30));
+	const __m256  l_cos_sign =
+		_mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(l_q, l_one), l_two), 30));
+	s.v = _mm256_xor_ps(_mm256_blendv_ps(l_sin, l_cos, l_swap), l_sin_sign);
+	c.v = _mm256_xor_ps(_mm256_blendv_ps(l_cos, l_sin, l_swap), l_cos_sign);
+}
+
+static void StoreMatrices(const LaneAvx (&columns)[12], glm::mat4* matrices)
+{
+	// Each 128-bit half holds 4 entities
+	__m128 l_low[12];
+	__m128 l_high[12];
+	for (uint64_t l_index = 0; l_index < 12; ++l_index)
+	{
+		l_low[l_index]	= _mm256_castps256_ps128(columns[l_index].v);
+		l_high[l_index] = _mm256_extractf128_ps(columns[l_index].v, 1);
+	}
+	StoreMatrices(l_low, matrices);
+	StoreMatrices(l_high, matrices + 4);
+}
+
+#endif
+
+/**
+ * @brief World matrices of the entities [index, index + Lane width).
+ */
+template<typename Lane>
+static void WorldMatrixLanes(const SoaStreams& location, const SoaStreams& rotation, const SoaStreams& scale,
+							 const uint64_t index, glm::mat4* matrices)
+{
+	const Lane l_half = Lane::Set(0.5f);
+	Lane	   l_sx, l_cx, l_sy, l_cy, l_sz, l_cz;
+	SinCos(Lane::Load(rotation.x + index) * l_half, l_sx, l_cx);
+	SinCos(Lane::Load(rotation.y + index) * l_half, l_sy, l_cy);
+	SinCos(Lane::Load(rotation.z + index) * l_half, l_sz, l_cz);
+
+	// Quaternion of the euler angles, as glm::quat(glm::vec3)
+	const Lane l_qw = l_cx * l_cy * l_cz + l_sx * l_sy * l_sz;
+	const Lane l_qx = l_sx * l_cy * l_cz - l_cx * l_sy * l_sz;
+	const Lane l_qy = l_cx * l_sy * l_cz + l_sx * l_cy * l_sz;
+	const Lane l_qz = l_cx * l_cy * l_sz - l_sx * l_sy * l_cz;
+
+	const Lane l_two = Lane::Set(2.f);
+	const Lane l_xx	 = l_qx * l_qx;
+	const Lane l_yy	 = l_qy * l_qy;
+	const Lane l_zz	 = l_qz * l_qz;
+	const Lane l_xy	 = l_qx * l_qy;
+	const Lane l_xz	 = l_qx * l_qz;
+	const Lane l_yz	 = l_qy * l_qz;
+	const Lane l_wx	 = l_qw * l_qx;
+	const Lane l_wy	 = l_qw * l_qy;
+	const Lane l_wz	 = l_qw * l_qz;
+
+	// Rotation as glm::mat3_cast, every column multiplied by its scale, then the translation column
+	const Lane l_one	 = Lane::Set(1.f);
+	const Lane l_scale_x = Lane::Load(scale.x + index);
+	const Lane l_scale_y = Lane::Load(scale.y + index);
+	const Lane l_scale_z = Lane::Load(scale.z + index);
+	const Lane l_columns[12] = {
+		(l_one - l_two * (l_yy + l_zz)) * l_scale_x, l_two * (l_xy + l_wz) * l_scale_x,
+		l_two * (l_xz - l_wy) * l_scale_x,			 l_two * (l_xy - l_wz) * l_scale_y,
+		(l_one - l_two * (l_xx + l_zz)) * l_scale_y, l_two * (l_yz + l_wx) * l_scale_y,
+		l_two * (l_xz + l_wy) * l_scale_z,			 l_two * (l_yz - l_wx) * l_scale_z,
+		(l_one - l_two * (l_xx + l_yy)) * l_scale_z, Lane::Load(location.x + index),
+		Lane::Load(location.y + index),				 Lane::Load(location.z + index)};
+	StoreMatrices(l_columns, matrices + index);
+}
+
+} // namespace Detail
+
+void ComputeWorldMatrices(const SoaStreams& location, const SoaStreams& rotation, const SoaStreams& scale,
+						  const uint64_t count, glm::mat4* matrices)
+{
+	uint64_t l_index = 0;
+#if CPU_X86
+	for (; l_index + ECS_TRANSFORM_BATCH <= count; l_index += ECS_TRANSFORM_BATCH)
+	{
+#if ECS_TRANSFORM_AVX2
+		Detail::WorldMatrixLanes<Detail::LaneAvx>(location, rotation, scale, l_index, matrices);
+#else
+		Detail::WorldMatrixLanes<Detail::LaneSse>(location, rotation, scale, l_index, matrices);
+		Detail::WorldMatrixLanes<Detail::LaneSse>(location, rotation, scale, l_index + 4, matrices);
+#endif
+	}
+#endif
+	for (; l_index < count; ++l_index)
+	{
+		Detail::WorldMatrixLanes<Detail::LaneScalar>(location, rotation, scale, l_index, matrices);
+	}
+}
+
+} // namespace Ecs
@@ -0,0 +1,128 @@
+/** @file Transform.h
+ *
+ * Copyright 2023 CoffeeAddict. All rights reserved.
+ * This file is part of COAD and it is private.
+ * You cannot copy, modify or share this file.
+ *
+ */
+
+#ifndef ECS_TRANSFORM_H
+#define ECS_TRANSFORM_H
+
+#include "Core/Common.h"
+#include "ECS/Registry.h"
+
+/**
+ * @brief Entities per kernel batch, one AVX2 register or two SSE registers.
+ */
+#define ECS_TRANSFORM_BATCH 8ull
+
+namespace Ecs
+{
+
+/**
+ * @brief Compute world matrices from SoA streams.
+ *
+ * The matrix is translate(location) * rotate(quat(rotation)) * scale(scale), the same of
+ * glm::translate * glm::mat4_cast(@ref RotationComponent::toQuat()) * glm::scale.
+ * Entities are processed in batches of @ref ECS_TRANSFORM_BATCH with AVX2 when the build enables it, otherwise
+ * with SSE2. The tail that does not fill a batch runs in scalar code.
+ *
+ * @param location Location streams.
+ * @param rotation Rotation streams, euler angles in radians.
+ * @param scale Scale streams.
+ * @param count Elements of every stream.
+ * @param matrices Output, count matrices.
+ *
+ */
+void ComputeWorldMatrices(const SoaStreams& location, const SoaStreams& rotation, const SoaStreams& scale,
+						  uint64_t count, glm::mat4* matrices);
+
+/**
+ * @brief Compute the world matrix of every entity of the registry.
+ *
+ * The three components must use SoA storage (@ref ComponentStorage::eSoa). Matrices are indexed by entity id.
+ * Kernels run over whole pages, so only the matrices of entities that have the three components are meaningful,
+ * pages without any of them are skipped.
+ *
+ * @param registry Source registry.
+ * @param matrices Output, at least @ref Registry::Capacity matrices.
+ *
+ */
+template<typename Location = LocationComponent, typename Rotation = RotationComponent,
+		 typename Scale = ScaleComponent, typename TypeList>
+void ComputeWorldMatrices(Registry<TypeList>& registry, eastl::span<glm::mat4> matrices, RESULT_PARAM_DEFINE);
+
+/**
+ * @brief Turn the matrices of @ref ComputeWorldMatrices into world matrices along the hierarchy.
+ *
+ * One linear pass over @ref HierarchyComponent in storage order: every parent is final before its children, and the
+ * world matrix of the last entity of each depth is kept on a stack, so no parent is looked up. Entities without
+ * hierarchy component keep their matrix.
+ *
+ * @param registry Source registry.
+ * @param matrices Local matrices as input, world matrices as output, at least @ref Registry::Capacity matrices.
+ *
+ */
+template<typename TypeList>
+void PropagateWorldMatrices(Registry<TypeList>& registry, eastl::span<glm::mat4> matrices, RESULT_PARAM_DEFINE);
+
+template<typename Location, typename Rotation, typename Scale, typename TypeList>
+void ComputeWorldMatrices(Registry<TypeList>& registry, const eastl::span<glm::mat4> matrices, RESULT_PARAM_IMPL)
+{
+	static_assert(IsSoaComponent<Location>::VALUE && IsSoaComponent<Rotation>::VALUE && IsSoaComponent<Scale>::VALUE,
+				  "World matrices are computed from SoA components only.");
+	RESULT_ENSURE_LAST_NOLOG();
+	const uint64_t l_capacity = registry.Capacity();
+	if (matrices.size() < l_capacity)
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+
+	constexpr uint64_t l_page_size = PagedArray<float32_t>::PAGE_SIZE;
+	for (uint64_t l_page = 0; l_page * l_page_size < l_capacity; ++l_page)
+	{
+		const SoaStreams l_location = registry.template Streams<Location>(l_page);
+		const SoaStreams l_rotation = registry.template Streams<Rotation>(l_page);
+		const SoaStreams l_scale	= registry.template Streams<Scale>(l_page);
+		if (!l_location.x || !l_rotation.x || !l_scale.x)
+		{
+			continue;
+		}
+		const uint64_t l_first = l_page * l_page_size;
+		ComputeWorldMatrices(l_location, l_rotation, l_scale, eastl::min(l_page_size, l_capacity - l_first),
+							 matrices.data() + l_first);
+	}
+	RESULT_OK();
+}
+
+template<typename TypeList>
+void PropagateWorldMatrices(Registry<TypeList>& registry, const eastl::span<glm::mat4> matrices, RESULT_PARAM_IMPL)
+{
+	RESULT_ENSURE_LAST_NOLOG();
+	if (matrices.size() < registry.Capacity())
+	{
+		RESULT_ERROR(EcsInvalidSpanSize);
+	}
+
+	eastl::vector<glm::mat4> l_stack{};
+	registry.EachHierarchy(
+		[&](const entity_id_t id, const HierarchyComponent& node)
+		{
+			glm::mat4& l_matrix = matrices[id];
+			if (node.depth)
+			{
+				l_matrix = l_stack[node.depth - 1] * l_matrix;
+			}
+			if (l_stack.size() <= node.depth)
+			{
+				l_stack.resize(node.depth + 1);
+			}
+			l_stack[node.depth] = l_matrix;
+		});
+	RESULT_OK();
+}
+
+} // namespace Ecs
+
+#endif
@@ -4,5 +4,6 @@
 #include "Core/Log.cpp"
 #include "Core/IO.cpp"
 #include "Core/Thread.cpp"
+#include "Core/JobPool.cpp"
 #include "Core/Paths.cpp"
 #include "Core/Gc.cpp"
@@ -1 +1,2 @@
-
+#include "ECS/Transform.cpp"
+#include "ECS/Registry.cpp"